@@ -0,0 +1,24 @@
+#ifndef DELTA_K_BASELINE_HPP
+#define DELTA_K_BASELINE_HPP
+
+#include <string>
+
+/**
+ * @brief The original character-by-character codec, frozen as the reference every
+ * benchmark speed-up is measured against. Do not optimize it.
+ *
+ * It predates Delta Mode decryption, so there is no keyed decrypt().
+ */
+namespace baseline {
+
+std::string encrypt(const std::string& plaintext);
+std::string encrypt(const std::string& plaintext, const std::string& key);
+std::string decrypt(const std::string& ciphertext);
+
+int abcPosition(char abc);
+bool isGlyph(std::string c);
+int glyphVal(std::string c);
+
+}
+
+#endif
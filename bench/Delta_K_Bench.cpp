@@ -0,0 +1,530 @@
+/**
+ * @brief delta-k-bench: throughput of every codec path, per kernel tier.
+ *
+ * For each input size and letter density it times encrypt(), keyed encrypt(), decrypt()
+ * and keyed decrypt() on every kernel tier this host supports, the frozen original
+ * implementation (see Delta_K_Baseline.hpp) and the helpers abcPosition(), isGlyph()
+ * and glyphVal(). Every result is the median of several repetitions, reported as MB/s
+ * in, MB/s out, ns per input character and the speed-up over the baseline, as a table
+ * and optionally as JSON.
+ */
+
+#include "Delta_K.hpp"
+#include "Delta_K_Baseline.hpp"
+#include "Delta_K_Corpus.hpp"
+#include "Delta_K_Dispatch.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <climits>
+#include <cstdlib>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <vector>
+
+/**
+ * @brief The options given on the command line (see parseArguments()).
+ */
+struct BenchOptions {
+    std::vector<size_t> sizes = {1024, 64 * 1024, 1024 * 1024};
+    std::vector<double> densities = {0.2, 0.6, 0.95};
+    std::vector<std::string> tiers;
+    std::string key = "Kryptos";
+    unsigned repetitions = 5;
+    double minTime = 0.02;
+    unsigned seed = 1;
+    std::string json;
+};
+
+/**
+ * @brief The most timed repetitions --repetitions takes per benchmark.
+ */
+constexpr uint64_t MAX_REPETITIONS = 1000000;
+
+/**
+ * @brief One benchmark: a function on one tier, size and density, with the time per call
+ * of every repetition.
+ */
+struct BenchResult {
+    std::string function;
+    std::string mode;
+    std::string tier;
+    size_t size = 0;
+    double density = 0;
+    size_t bytesIn = 0;
+    size_t bytesOut = 0;
+    std::vector<double> samples;
+    double median = 0;
+    double speedup = 0;
+};
+
+/**
+ * @brief The inputs of one size and density.
+ */
+struct BenchInput {
+    std::string plaintext;
+    std::string standard;
+    std::string keyed;
+    std::vector<std::string> pieces;
+};
+
+/**
+ * @brief The tier name of the frozen original implementation.
+ */
+const char* const BASELINE_TIER = "baseline";
+
+/**
+ * @brief The tier name of the helpers, which do not depend on the kernels.
+ */
+const char* const ANY_TIER = "any";
+
+/**
+ * @brief Keeps results the compiler must not optimize away.
+ */
+static volatile size_t benchSink;
+
+/**
+ * @brief Splits a comma-separated list.
+ */
+static std::vector<std::string> splitList(const std::string& text) {
+    std::vector<std::string> items;
+    std::stringstream stream(text);
+    std::string item;
+
+    while (std::getline(stream, item, ',')) {
+        if (!item.empty()) items.push_back(item);
+    }
+
+    return items;
+}
+
+/**
+ * @brief Reads a non-negative number, reporting a bad one to stderr.
+ */
+static bool parseNumber(const std::string& name, const std::string& text, double& number) {
+    char* end;
+    number = std::strtod(text.c_str(), &end);
+
+    if (end == text.c_str() || *end || !(number >= 0)) {
+        std::cerr << "Invalid " << name << ": " << text << std::endl;
+        return false;
+    }
+
+    return true;
+}
+
+/**
+ * @brief Prints the command-line usage to stderr.
+ */
+static void printUsage(const char* program) {
+    std::cerr << "Usage: " << program << " [options]" << std::endl
+              << "  --sizes LIST        input sizes, e.g. 1K,64K,1M (default)" << std::endl
+              << "  --densities LIST    fractions of letters, e.g. 0.2,0.6,0.95 (default)" << std::endl
+              << "  --tiers LIST        scalar, swar, sse4.2, avx2, avx512, baseline (default: all supported)"
+              << std::endl
+              << "  --key KEY           the Delta Mode key (default: Kryptos)" << std::endl
+              << "  --repetitions N     timed repetitions per benchmark (default: 5)" << std::endl
+              << "  --min-time SECONDS  the least time per repetition (default: 0.02)" << std::endl
+              << "  --seed N            the input generator seed (default: 1)" << std::endl
+              << "  --json FILE         also write the results as JSON" << std::endl;
+}
+
+/**
+ * @brief Reads the command line into `options`, reporting any error to stderr.
+ *
+ * @return true If every argument was understood.
+ */
+static bool parseArguments(int argc, char* argv[], BenchOptions& options) {
+    for (int i = 1; i < argc; i++) {
+        const std::string argument = argv[i];
+
+        if (argument == "-h" || argument == "--help") {
+            printUsage(argv[0]);
+            return false;
+        }
+        if (i + 1 >= argc) {
+            std::cerr << "Unknown or incomplete option: " << argument << std::endl;
+            printUsage(argv[0]);
+            return false;
+        }
+
+        const std::string value = argv[++i];
+        if (argument == "--sizes") {
+            options.sizes.clear();
+            for (const std::string& item : splitList(value)) {
+                size_t size;
+                if (!parseSize(item, size)) {
+                    std::cerr << "Invalid size: " << item << std::endl;
+                    return false;
+                }
+                options.sizes.push_back(size);
+            }
+        } else if (argument == "--densities") {
+            options.densities.clear();
+            for (const std::string& item : splitList(value)) {
+                double density;
+                if (!parseNumber("density", item, density)) return false;
+                if (density > 1) {
+                    std::cerr << "Invalid density: " << item << std::endl;
+                    return false;
+                }
+                options.densities.push_back(density);
+            }
+        } else if (argument == "--tiers") {
+            options.tiers = splitList(value);
+        } else if (argument == "--key") {
+            if (!keyValidation(value)) {
+                std::cerr << "Invalid key: " << value << std::endl;
+                return false;
+            }
+            options.key = value;
+        } else if (argument == "--repetitions") {
+            uint64_t repetitions;
+            if (!parseCount(value, 1, MAX_REPETITIONS, repetitions)) {
+                std::cerr << "Invalid repetition count: " << value << std::endl;
+                return false;
+            }
+            options.repetitions = static_cast<unsigned>(repetitions);
+        } else if (argument == "--min-time") {
+            if (!parseNumber("minimum time", value, options.minTime)) return false;
+        } else if (argument == "--seed") {
+            uint64_t seed;
+            if (!parseCount(value, 0, UINT_MAX, seed)) {
+                std::cerr << "Invalid seed: " << value << std::endl;
+                return false;
+            }
+            options.seed = static_cast<unsigned>(seed);
+        } else if (argument == "--json") {
+            options.json = value;
+        } else {
+            std::cerr << "Unknown option: " << argument << std::endl;
+            printUsage(argv[0]);
+            return false;
+        }
+    }
+
+    return !options.sizes.empty() && !options.densities.empty();
+}
+
+/**
+ * @brief Builds the inputs of one size and density. `pieces` are the strings the
+ * original decrypt() hands to isGlyph() and glyphVal(): a glyph, or three bytes that
+ * are not one.
+ */
+static BenchInput makeInput(size_t size, double density, const BenchOptions& options) {
+    BenchInput input;
+    CorpusProfile profile;
+    profile.letters = density;
+    profile.seed = options.seed;
+
+    input.plaintext = CorpusGenerator(profile).text(size);
+    input.standard = encrypt(input.plaintext);
+    input.keyed = encrypt(input.plaintext, options.key);
+
+    for (size_t i = 0; i < input.standard.length() && input.pieces.size() < size;) {
+        input.pieces.push_back(input.standard.substr(i, GLYPH_SIZE));
+        i += isGlyph(input.pieces.back()) ? GLYPH_SIZE : 1;
+    }
+
+    return input;
+}
+
+/**
+ * @brief Times a call: calibrates the calls per repetition to last at least minTime,
+ * then records the time per call of every repetition, in nanoseconds.
+ *
+ * @param call Returns the number of output bytes, which is kept from the optimizer.
+ */
+template <typename Call>
+static std::vector<double> measure(Call call, const BenchOptions& options) {
+    using Clock = std::chrono::steady_clock;
+
+    size_t calls = 1;
+    for (;;) {
+        const Clock::time_point start = Clock::now();
+        for (size_t c = 0; c < calls; c++) benchSink = call();
+        const double seconds = std::chrono::duration<double>(Clock::now() - start).count();
+
+        if (seconds >= options.minTime) break;
+        calls = seconds > 0 ? std::max(calls * 2, static_cast<size_t>(calls * options.minTime * 1.2 / seconds))
+                            : calls * 10;
+    }
+
+    std::vector<double> samples;
+    for (unsigned r = 0; r < options.repetitions; r++) {
+        const Clock::time_point start = Clock::now();
+        for (size_t c = 0; c < calls; c++) benchSink = call();
+        const double seconds = std::chrono::duration<double>(Clock::now() - start).count();
+        samples.push_back(seconds * 1e9 / static_cast<double>(calls));
+    }
+
+    return samples;
+}
+
+/**
+ * @brief Returns the median of a set of samples.
+ */
+static double median(std::vector<double> samples) {
+    std::sort(samples.begin(), samples.end());
+    const size_t middle = samples.size() / 2;
+    return samples.size() % 2 ? samples[middle] : (samples[middle - 1] + samples[middle]) / 2;
+}
+
+/**
+ * @brief Times one call and adds it to the results.
+ */
+template <typename Call>
+static void run(std::vector<BenchResult>& results, const std::string& function, const std::string& mode,
+                const std::string& tier, size_t size, double density, size_t bytesIn, size_t bytesOut, Call call,
+                const BenchOptions& options) {
+    BenchResult result;
+    result.function = function;
+    result.mode = mode;
+    result.tier = tier;
+    result.size = size;
+    result.density = density;
+    result.bytesIn = bytesIn;
+    result.bytesOut = bytesOut;
+    result.samples = measure(call, options);
+    result.median = median(result.samples);
+    results.push_back(result);
+}
+
+/**
+ * @brief Runs the four codec paths on the bound kernel tier.
+ */
+static void runCodec(std::vector<BenchResult>& results, const std::string& tier, const BenchInput& input,
+                     size_t size, double density, const BenchOptions& options) {
+    const std::string& key = options.key;
+
+    run(results, "encrypt", "standard", tier, size, density, input.plaintext.size(), input.standard.size(),
+        [&] { return encrypt(input.plaintext).size(); }, options);
+    run(results, "encrypt", "keyed", tier, size, density, input.plaintext.size(), input.keyed.size(),
+        [&] { return encrypt(input.plaintext, key).size(); }, options);
+    run(results, "decrypt", "standard", tier, size, density, input.standard.size(), input.plaintext.size(),
+        [&] { return decrypt(input.standard).size(); }, options);
+    run(results, "decrypt", "keyed", tier, size, density, input.keyed.size(), input.plaintext.size(),
+        [&] { return decrypt(input.keyed, key).size(); }, options);
+}
+
+/**
+ * @brief Runs the frozen original implementation. It has no keyed decrypt().
+ */
+static void runBaseline(std::vector<BenchResult>& results, const BenchInput& input, size_t size, double density,
+                        const BenchOptions& options) {
+    const std::string& key = options.key;
+
+    run(results, "encrypt", "standard", BASELINE_TIER, size, density, input.plaintext.size(), input.standard.size(),
+        [&] { return baseline::encrypt(input.plaintext).size(); }, options);
+    run(results, "encrypt", "keyed", BASELINE_TIER, size, density, input.plaintext.size(), input.keyed.size(),
+        [&] { return baseline::encrypt(input.plaintext, key).size(); }, options);
+    run(results, "decrypt", "standard", BASELINE_TIER, size, density, input.standard.size(), input.plaintext.size(),
+        [&] { return baseline::decrypt(input.standard).size(); }, options);
+}
+
+/**
+ * @brief Runs the helpers, current and original, once per input character (abcPosition)
+ * or once per piece (isGlyph and glyphVal).
+ */
+static void runHelpers(std::vector<BenchResult>& results, const BenchInput& input, size_t size, double density,
+                       bool withBaseline, const BenchOptions& options) {
+    const std::string& text = input.plaintext;
+    const std::vector<std::string>& pieces = input.pieces;
+    const size_t pieceBytes = pieces.size() * GLYPH_SIZE;
+
+    auto positions = [&](auto function) {
+        return [&text, function] {
+            size_t total = 0;
+            for (char c : text) total += static_cast<size_t>(function(c));
+            return total;
+        };
+    };
+    auto glyphs = [&](auto function) {
+        return [&pieces, function] {
+            size_t total = 0;
+            for (const std::string& piece : pieces) total += static_cast<size_t>(function(piece));
+            return total;
+        };
+    };
+
+    run(results, "abcPosition", "none", ANY_TIER, size, density, text.size(), text.size() * sizeof(int),
+        positions([](char c) { return abcPosition(c); }), options);
+    run(results, "isGlyph", "none", ANY_TIER, size, density, pieceBytes, pieces.size(),
+        glyphs([](const std::string& c) { return isGlyph(c); }), options);
+    run(results, "glyphVal", "none", ANY_TIER, size, density, pieceBytes, pieces.size() * sizeof(int),
+        glyphs([](const std::string& c) { return glyphVal(c); }), options);
+
+    if (!withBaseline) return;
+
+    run(results, "abcPosition", "none", BASELINE_TIER, size, density, text.size(), text.size() * sizeof(int),
+        positions([](char c) { return baseline::abcPosition(c); }), options);
+    run(results, "isGlyph", "none", BASELINE_TIER, size, density, pieceBytes, pieces.size(),
+        glyphs([](const std::string& c) { return baseline::isGlyph(c); }), options);
+    run(results, "glyphVal", "none", BASELINE_TIER, size, density, pieceBytes, pieces.size() * sizeof(int),
+        glyphs([](const std::string& c) { return baseline::glyphVal(c); }), options);
+}
+
+/**
+ * @brief Fills in every result's speed-up over the baseline run of the same function,
+ * mode, size and density; 0 where there is none.
+ */
+static void computeSpeedups(std::vector<BenchResult>& results) {
+    for (BenchResult& result : results) {
+        for (const BenchResult& reference : results) {
+            if (reference.tier == BASELINE_TIER && reference.function == result.function &&
+                reference.mode == result.mode && reference.size == result.size &&
+                reference.density == result.density && result.median > 0) {
+                result.speedup = reference.median / result.median;
+            }
+        }
+    }
+}
+
+/**
+ * @brief Returns a result's input throughput in MB/s (10^6 bytes per second).
+ */
+static double megabytesIn(const BenchResult& result) {
+    return result.median > 0 ? static_cast<double>(result.bytesIn) * 1e3 / result.median : 0;
+}
+
+static double megabytesOut(const BenchResult& result) {
+    return result.median > 0 ? static_cast<double>(result.bytesOut) * 1e3 / result.median : 0;
+}
+
+/**
+ * @brief Returns a result's time per input character, in nanoseconds.
+ */
+static double nanosPerChar(const BenchResult& result) {
+    return result.bytesIn ? result.median / static_cast<double>(result.bytesIn) : 0;
+}
+
+/**
+ * @brief Prints the results as a table.
+ */
+static void printTable(const std::vector<BenchResult>& results) {
+    std::cout << std::left << std::setw(12) << "function" << std::setw(10) << "mode" << std::setw(10) << "tier"
+              << std::right << std::setw(10) << "size" << std::setw(9) << "density" << std::setw(12) << "MB/s in"
+              << std::setw(12) << "MB/s out" << std::setw(10) << "ns/char" << std::setw(10) << "speed-up"
+              << std::endl;
+
+    for (const BenchResult& result : results) {
+        std::cout << std::left << std::setw(12) << result.function << std::setw(10) << result.mode << std::setw(10)
+                  << result.tier << std::right << std::setw(10) << result.size << std::fixed << std::setprecision(2)
+                  << std::setw(9) << result.density << std::setw(12) << megabytesIn(result) << std::setw(12)
+                  << megabytesOut(result) << std::setprecision(3) << std::setw(10) << nanosPerChar(result);
+
+        if (result.speedup > 0) {
+            std::cout << std::setprecision(2) << std::setw(9) << result.speedup << "x";
+        } else {
+            std::cout << std::setw(10) << "-";
+        }
+        std::cout << std::defaultfloat << std::endl;
+    }
+}
+
+/**
+ * @brief Writes the results as JSON: the run's settings, then one object per benchmark
+ * with its time per call (ns) in every repetition.
+ *
+ * @return true If the file was written.
+ */
+static bool writeJson(const std::string& path, const std::vector<BenchResult>& results, const BenchOptions& options) {
+    std::ofstream out(path);
+    if (!out) {
+        std::cerr << "Cannot open " << path << " for writing" << std::endl;
+        return false;
+    }
+
+    out << std::setprecision(6);
+    out << "{\n  \"tool\": \"delta-k-bench\",\n  \"format\": 1,\n";
+    out << "  \"best_tier\": \"" << tierName(bestTier()) << "\",\n";
+    out << "  \"repetitions\": " << options.repetitions << ",\n  \"min_time\": " << options.minTime << ",\n";
+    out << "  \"seed\": " << options.seed << ",\n  \"results\": [";
+
+    for (size_t r = 0; r < results.size(); r++) {
+        const BenchResult& result = results[r];
+        out << (r ? "," : "") << "\n    {\"name\": \"" << result.function << "/" << result.mode << "/" << result.tier
+            << "/" << result.size << "/" << result.density << "\", \"function\": \"" << result.function
+            << "\", \"mode\": \"" << result.mode << "\", \"tier\": \"" << result.tier << "\", \"size\": "
+            << result.size << ", \"density\": " << result.density << ", \"bytes_in\": " << result.bytesIn
+            << ", \"bytes_out\": " << result.bytesOut << ", \"median_ns\": " << result.median
+            << ", \"mb_per_s_in\": " << megabytesIn(result) << ", \"mb_per_s_out\": " << megabytesOut(result)
+            << ", \"ns_per_char\": " << nanosPerChar(result) << ", \"speedup\": " << result.speedup
+            << ", \"samples_ns\": [";
+        for (size_t s = 0; s < result.samples.size(); s++) {
+            out << (s ? ", " : "") << result.samples[s];
+        }
+        out << "]}";
+    }
+
+    out << "\n  ]\n}\n";
+    return static_cast<bool>(out.flush());
+}
+
+/**
+ * @brief Picks the tiers to run: the ones named with --tiers, or every supported tier
+ * plus the baseline. Unknown or unsupported tiers are reported and skipped.
+ */
+static std::vector<std::string> chooseTiers(const BenchOptions& options) {
+    std::vector<std::string> tiers;
+
+    if (options.tiers.empty()) {
+        for (int t = 0; t <= static_cast<int>(KernelTier::AVX512); t++) {
+            if (tierSupported(static_cast<KernelTier>(t))) tiers.push_back(tierName(static_cast<KernelTier>(t)));
+        }
+        tiers.push_back(BASELINE_TIER);
+        return tiers;
+    }
+
+    for (const std::string& name : options.tiers) {
+        KernelTier tier;
+        if (name == BASELINE_TIER) {
+            tiers.push_back(name);
+        } else if (!parseTier(name, tier)) {
+            std::cerr << "Unknown tier '" << name << "', skipped" << std::endl;
+        } else if (!tierSupported(tier)) {
+            std::cerr << "Tier '" << name << "' is not supported on this CPU, skipped" << std::endl;
+        } else {
+            tiers.push_back(tierName(tier));
+        }
+    }
+
+    return tiers;
+}
+
+int main(int argc, char* argv[]) {
+    BenchOptions options;
+    if (!parseArguments(argc, argv, options)) return 1;
+
+    const std::vector<std::string> tiers = chooseTiers(options);
+    const bool withBaseline = std::find(tiers.begin(), tiers.end(), BASELINE_TIER) != tiers.end();
+    std::vector<BenchResult> results;
+
+    for (size_t size : options.sizes) {
+        for (double density : options.densities) {
+            const BenchInput input = makeInput(size, density, options);
+
+            for (const std::string& name : tiers) {
+                KernelTier tier;
+                if (name == BASELINE_TIER) {
+                    runBaseline(results, input, size, density, options);
+                } else if (parseTier(name, tier) && selectTier(tier)) {
+                    runCodec(results, name, input, size, density, options);
+                }
+            }
+
+            selectTier(bestTier());
+            runHelpers(results, input, size, density, withBaseline, options);
+        }
+    }
+
+    computeSpeedups(results);
+    printTable(results);
+
+    if (!options.json.empty() && !writeJson(options.json, results, options)) return 1;
+
+    return 0;
+}
@@ -0,0 +1,426 @@
+/**
+ * @brief delta-k-bench-compare: compares two delta-k-bench (or delta-k-latency) JSON
+ * result files and fails when a benchmark got slower.
+ *
+ * Benchmarks are matched by name. For each, the median of its samples is compared, and
+ * the change only counts when it stands out of the noise: it must exceed `--noise` times
+ * the combined spread of the two runs, measured as the median absolute deviation (MAD)
+ * of their samples. A significant slow-down beyond `--threshold` percent is a
+ * regression, and makes the tool exit with 1.
+ */
+
+#include <algorithm>
+#include <cctype>
+#include <cmath>
+#include <cstdlib>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <map>
+#include <sstream>
+#include <string>
+#include <utility>
+#include <vector>
+
+/**
+ * @brief The options given on the command line (see parseArguments()).
+ */
+struct CompareOptions {
+    std::string baselinePath;
+    std::string candidatePath;
+    double threshold = 5.0;
+    double noise = 2.0;
+    std::string filter;
+};
+
+/**
+ * @brief Scales a MAD to the standard deviation of normally distributed samples.
+ */
+constexpr double MAD_SCALE = 1.4826;
+
+/**
+ * @brief A parsed JSON value. Only what the result files use is kept: objects keep
+ * their members in order, and numbers are doubles.
+ */
+struct JsonValue {
+    enum class Type { Null, Boolean, Number, String, Array, Object };
+
+    Type type = Type::Null;
+    bool boolean = false;
+    double number = 0;
+    std::string text;
+    std::vector<JsonValue> items;
+    std::vector<std::pair<std::string, JsonValue>> members;
+
+    const JsonValue* member(const std::string& name) const {
+        for (const auto& entry : members) {
+            if (entry.first == name) return &entry.second;
+        }
+        return nullptr;
+    }
+};
+
+/**
+ * @brief A small recursive-descent JSON reader, enough for the result files; it reports
+ * the offset of the first error.
+ */
+class JsonReader {
+public:
+    explicit JsonReader(const std::string& text) : text(text) {}
+
+    bool read(JsonValue& value) {
+        if (!readValue(value)) return false;
+        skipSpace();
+        return position == text.size() || fail("trailing characters");
+    }
+
+    const std::string& error() const { return message; }
+
+private:
+    bool fail(const char* what) {
+        if (message.empty()) message = std::string(what) + " at offset " + std::to_string(position);
+        return false;
+    }
+
+    void skipSpace() {
+        while (position < text.size() && std::isspace(static_cast<unsigned char>(text[position]))) position++;
+    }
+
+    bool consume(char c) {
+        skipSpace();
+        if (position < text.size() && text[position] == c) {
+            position++;
+            return true;
+        }
+        return false;
+    }
+
+    bool readLiteral(const char* literal) {
+        const size_t length = std::char_traits<char>::length(literal);
+        if (text.compare(position, length, literal) != 0) return fail("unknown literal");
+        position += length;
+        return true;
+    }
+
+    bool readString(std::string& out) {
+        if (!consume('"')) return fail("expected a string");
+
+        while (position < text.size() && text[position] != '"') {
+            char c = text[position++];
+            if (c == '\\') {
+                if (position >= text.size()) break;
+                c = text[position++];
+                switch (c) {
+                    case 'n': c = '\n'; break;
+                    case 't': c = '\t'; break;
+                    case 'r': c = '\r'; break;
+                    case 'b': c = '\b'; break;
+                    case 'f': c = '\f'; break;
+                    case 'u':
+                        // Names never hold escaped code points; keep them visible rather than decode.
+                        out += "\\u";
+                        continue;
+                    default: break;
+                }
+            }
+            out += c;
+        }
+
+        if (position >= text.size()) return fail("unterminated string");
+        position++;
+        return true;
+    }
+
+    bool readValue(JsonValue& value) {
+        skipSpace();
+        if (position >= text.size()) return fail("unexpected end");
+
+        const char c = text[position];
+        if (c == '{') {
+            position++;
+            value.type = JsonValue::Type::Object;
+            if (consume('}')) return true;
+            do {
+                std::string name;
+                JsonValue member;
+                if (!readString(name)) return false;
+                if (!consume(':')) return fail("expected ':'");
+                if (!readValue(member)) return false;
+                value.members.emplace_back(std::move(name), std::move(member));
+            } while (consume(','));
+            return consume('}') || fail("expected '}'");
+        }
+        if (c == '[') {
+            position++;
+            value.type = JsonValue::Type::Array;
+            if (consume(']')) return true;
+            do {
+                value.items.emplace_back();
+                if (!readValue(value.items.back())) return false;
+            } while (consume(','));
+            return consume(']') || fail("expected ']'");
+        }
+        if (c == '"') {
+            value.type = JsonValue::Type::String;
+            return readString(value.text);
+        }
+        if (c == 't' || c == 'f') {
+            value.type = JsonValue::Type::Boolean;
+            value.boolean = c == 't';
+            return readLiteral(c == 't' ? "true" : "false");
+        }
+        if (c == 'n') return readLiteral("null");
+
+        char* end;
+        value.type = JsonValue::Type::Number;
+        value.number = std::strtod(text.c_str() + position, &end);
+        if (end == text.c_str() + position) return fail("unexpected character");
+        position = static_cast<size_t>(end - text.c_str());
+        return true;
+    }
+
+    const std::string& text;
+    size_t position = 0;
+    std::string message;
+};
+
+/**
+ * @brief One benchmark of a result file: its name and timed samples.
+ */
+struct Benchmark {
+    std::string name;
+    std::vector<double> samples;
+};
+
+/**
+ * @brief The benchmarks of a result file, in file order.
+ */
+struct ResultFile {
+    std::string tool;
+    std::vector<Benchmark> benchmarks;
+};
+
+/**
+ * @brief Reads a result file, reporting any error to stderr. A record without samples
+ * counts its median as its only sample.
+ *
+ * @return true If the file was read and has a results array.
+ */
+static bool readResults(const std::string& path, ResultFile& results) {
+    std::ifstream in(path, std::ios::binary);
+    if (!in) {
+        std::cerr << "Cannot open " << path << std::endl;
+        return false;
+    }
+
+    std::stringstream buffer;
+    buffer << in.rdbuf();
+    const std::string text = buffer.str();
+    JsonValue root;
+    JsonReader reader(text);
+
+    if (!reader.read(root)) {
+        std::cerr << path << ": " << reader.error() << std::endl;
+        return false;
+    }
+
+    const JsonValue* tool = root.member("tool");
+    const JsonValue* records = root.member("results");
+    if (!records || records->type != JsonValue::Type::Array) {
+        std::cerr << path << ": no results array" << std::endl;
+        return false;
+    }
+    if (tool) results.tool = tool->text;
+
+    for (const JsonValue& record : records->items) {
+        const JsonValue* name = record.member("name");
+        const JsonValue* samples = record.member("samples_ns");
+        const JsonValue* median = record.member("median_ns");
+        if (!name || name->type != JsonValue::Type::String) continue;
+
+        Benchmark benchmark;
+        benchmark.name = name->text;
+        if (samples) {
+            for (const JsonValue& sample : samples->items) {
+                if (sample.type == JsonValue::Type::Number) benchmark.samples.push_back(sample.number);
+            }
+        }
+        if (benchmark.samples.empty() && median && median->type == JsonValue::Type::Number) {
+            benchmark.samples.push_back(median->number);
+        }
+        if (!benchmark.samples.empty()) results.benchmarks.push_back(std::move(benchmark));
+    }
+
+    return true;
+}
+
+/**
+ * @brief Returns the median of a set of samples.
+ */
+static double median(std::vector<double> samples) {
+    std::sort(samples.begin(), samples.end());
+    const size_t middle = samples.size() / 2;
+    return samples.size() % 2 ? samples[middle] : (samples[middle - 1] + samples[middle]) / 2;
+}
+
+/**
+ * @brief Returns the median absolute deviation of a set of samples from their median.
+ */
+static double medianDeviation(const std::vector<double>& samples, double center) {
+    std::vector<double> deviations;
+    deviations.reserve(samples.size());
+    for (double sample : samples) deviations.push_back(std::fabs(sample - center));
+    return median(deviations);
+}
+
+/**
+ * @brief Prints the command-line usage to stderr.
+ */
+static void printUsage(const char* program) {
+    std::cerr << "Usage: " << program << " BASELINE.json CANDIDATE.json [options]" << std::endl
+              << "  --threshold PCT     slow-down that fails the comparison (default: 5)" << std::endl
+              << "  --noise K           times the combined MAD a change must exceed (default: 2)" << std::endl
+              << "  --filter TEXT       compare only benchmarks whose name contains TEXT" << std::endl
+              << "Exits with 0 if nothing regressed, 1 on a regression and 2 on an error." << std::endl;
+}
+
+/**
+ * @brief Reads a non-negative number, reporting a bad one to stderr.
+ */
+static bool parseNumber(const std::string& name, const std::string& text, double& number) {
+    char* end;
+    number = std::strtod(text.c_str(), &end);
+
+    if (end == text.c_str() || *end || number < 0) {
+        std::cerr << "Invalid " << name << ": " << text << std::endl;
+        return false;
+    }
+
+    return true;
+}
+
+/**
+ * @brief Reads the command line into `options`, reporting any error to stderr.
+ *
+ * @return true If every argument was understood and both files were given.
+ */
+static bool parseArguments(int argc, char* argv[], CompareOptions& options) {
+    std::vector<std::string> files;
+
+    for (int i = 1; i < argc; i++) {
+        const std::string argument = argv[i];
+
+        if (argument.compare(0, 2, "--") != 0 && argument != "-h") {
+            files.push_back(argument);
+            continue;
+        }
+        if (argument == "-h" || argument == "--help" || i + 1 >= argc) {
+            printUsage(argv[0]);
+            return false;
+        }
+
+        const std::string value = argv[++i];
+        if (argument == "--threshold") {
+            if (!parseNumber("threshold", value, options.threshold)) return false;
+        } else if (argument == "--noise") {
+            if (!parseNumber("noise factor", value, options.noise)) return false;
+        } else if (argument == "--filter") {
+            options.filter = value;
+        } else {
+            std::cerr << "Unknown option: " << argument << std::endl;
+            printUsage(argv[0]);
+            return false;
+        }
+    }
+
+    if (files.size() != 2) {
+        printUsage(argv[0]);
+        return false;
+    }
+    options.baselinePath = files[0];
+    options.candidatePath = files[1];
+
+    return true;
+}
+
+int main(int argc, char* argv[]) {
+    CompareOptions options;
+    if (!parseArguments(argc, argv, options)) return 2;
+
+    ResultFile baseline, candidate;
+    if (!readResults(options.baselinePath, baseline) || !readResults(options.candidatePath, candidate)) return 2;
+
+    if (baseline.tool != candidate.tool) {
+        std::cerr << "Warning: comparing " << baseline.tool << " results with " << candidate.tool << " results"
+                  << std::endl;
+    }
+
+    std::map<std::string, const Benchmark*> candidates;
+    for (const Benchmark& benchmark : candidate.benchmarks) candidates[benchmark.name] = &benchmark;
+
+    size_t nameWidth = 9;
+    for (const Benchmark& benchmark : baseline.benchmarks) nameWidth = std::max(nameWidth, benchmark.name.size());
+
+    std::cout << std::left << std::setw(static_cast<int>(nameWidth) + 2) << "benchmark" << std::right
+              << std::setw(13) << "base ns" << std::setw(13) << "new ns" << std::setw(10) << "change"
+              << std::setw(10) << "noise" << "  verdict" << std::endl;
+
+    size_t compared = 0, regressions = 0, improvements = 0, fewSamples = 0;
+
+    for (const Benchmark& before : baseline.benchmarks) {
+        if (before.name.find(options.filter) == std::string::npos) continue;
+
+        const auto match = candidates.find(before.name);
+        if (match == candidates.end()) {
+            std::cerr << "Only in " << options.baselinePath << ": " << before.name << std::endl;
+            continue;
+        }
+        const Benchmark& after = *match->second;
+        candidates.erase(match);
+
+        const double beforeMedian = median(before.samples);
+        const double afterMedian = median(after.samples);
+        // The spread of both runs, scaled to a standard deviation and expressed relative to the baseline.
+        const double spread = MAD_SCALE * (medianDeviation(before.samples, beforeMedian) +
+                                           medianDeviation(after.samples, afterMedian));
+        const double change = beforeMedian > 0 ? 100.0 * (afterMedian - beforeMedian) / beforeMedian : 0;
+        const double noise = beforeMedian > 0 ? 100.0 * options.noise * spread / beforeMedian : 0;
+        const bool significant = std::fabs(change) > noise;
+
+        const char* verdict = "same";
+        if (significant && change > options.threshold) {
+            verdict = "REGRESSED";
+            regressions++;
+        } else if (significant && change < -options.threshold) {
+            verdict = "improved";
+            improvements++;
+        } else if (std::fabs(change) > options.threshold) {
+            verdict = "noisy";
+        }
+        if (before.samples.size() < 3 || after.samples.size() < 3) fewSamples++;
+        compared++;
+
+        std::cout << std::left << std::setw(static_cast<int>(nameWidth) + 2) << before.name << std::right
+                  << std::fixed << std::setprecision(1) << std::setw(13) << beforeMedian << std::setw(13)
+                  << afterMedian << std::showpos << std::setw(9) << change << "%" << std::noshowpos
+                  << std::setw(9) << noise << "%  " << verdict << std::defaultfloat
+                  << std::endl;
+    }
+
+    for (const Benchmark& benchmark : candidate.benchmarks) {
+        if (candidates.count(benchmark.name) && benchmark.name.find(options.filter) != std::string::npos) {
+            std::cerr << "Only in " << options.candidatePath << ": " << benchmark.name << std::endl;
+        }
+    }
+
+    if (fewSamples > 0) {
+        std::cerr << "Warning: " << fewSamples << " benchmark(s) have fewer than 3 samples; their noise is not known"
+                  << std::endl;
+    }
+
+    std::cout << std::endl
+              << compared << " compared, " << regressions << " regressed, " << improvements << " improved (threshold "
+              << options.threshold << "%, noise " << options.noise << " x MAD)" << std::endl;
+
+    return regressions > 0 ? 1 : 0;
+}
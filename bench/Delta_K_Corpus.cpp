@@ -0,0 +1,175 @@
+#include "Delta_K_Corpus.hpp"
+
+#include <algorithm>
+#include <cerrno>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+
+/**
+ * @brief The non-ASCII characters a corpus draws from: Latin letters with diacritics
+ * and typographic punctuation, as their UTF-8 bytes.
+ */
+static const char* const UTF8_CHARACTERS[8] = {"\xC3\xA9", "\xC3\xBC", "\xC3\xB1", "\xC3\x9F",
+                                               "\xE2\x80\x94", "\xE2\x80\x9C", "\xE2\x80\x9D", "\xE2\x82\xAC"};
+
+/**
+ * @brief The other characters, one of which is drawn uniformly: 36 spaces, 14
+ * punctuation marks, 10 digits and 4 newlines.
+ */
+static const char OTHER_CHARACTERS[] =
+    "                                    .,.,;:!?'\"-().0123456789\n\n\n\n";
+
+static_assert(sizeof(OTHER_CHARACTERS) - 1 == 64, "OTHER_CHARACTERS is indexed with 6 bits");
+
+/**
+ * @brief Scales a fraction to a threshold for `bits` random bits.
+ */
+static uint64_t fractionLimit(double fraction, int bits) {
+    const double clamped = std::min(std::max(fraction, 0.0), 1.0);
+    return static_cast<uint64_t>(clamped * static_cast<double>(uint64_t{1} << bits));
+}
+
+/**
+ * @brief Creates a generator; the same profile and seed always give the same text.
+ */
+CorpusGenerator::CorpusGenerator(const CorpusProfile& profile)
+    : random(profile.seed),
+      letterLimit(fractionLimit(profile.letters, 32)),
+      utf8Limit(std::min(letterLimit + fractionLimit(profile.utf8, 32), uint64_t{1} << 32)),
+      upperLimit(fractionLimit(profile.upper, 16)) {}
+
+/**
+ * @brief Draws the next character into `out` (up to 3 bytes) from one 64-bit draw: the
+ * low half picks its class, the high half the character.
+ *
+ * @return size_t The character's length in bytes.
+ */
+size_t CorpusGenerator::nextCharacter(char* out) {
+    const uint64_t draw = random.next();
+    const uint64_t pick = draw & 0xFFFFFFFFu;
+    const uint64_t high = draw >> 32;
+
+    if (pick < letterLimit) {
+        const char letter = static_cast<char>(((high & 0xFFFF) * 26) >> 16);
+        out[0] = static_cast<char>(((high >> 16) < upperLimit ? 'A' : 'a') + letter);
+        return 1;
+    }
+
+    if (pick < utf8Limit) {
+        const char* character = UTF8_CHARACTERS[high & 7];
+        const size_t length = std::strlen(character);
+        std::memcpy(out, character, length);
+        return length;
+    }
+
+    out[0] = OTHER_CHARACTERS[high & 63];
+    return 1;
+}
+
+/**
+ * @brief Generates whole characters into `out` until the next one does not fit; that one
+ * starts the next call, so the text does not depend on how it is cut.
+ *
+ * @param out The destination.
+ * @param capacity The bytes `out` holds.
+ * @return size_t The number of bytes written (at most 2 short of `capacity`).
+ */
+size_t CorpusGenerator::fill(char* out, size_t capacity) {
+    size_t written = 0;
+
+    for (;;) {
+        if (pendingLength == 0) pendingLength = nextCharacter(pending);
+        if (written + pendingLength > capacity) return written;
+
+        std::memcpy(out + written, pending, pendingLength);
+        written += pendingLength;
+        pendingLength = 0;
+    }
+}
+
+/**
+ * @brief Generates exactly `length` bytes of text. A multi-byte character that would
+ * cross the end is replaced with spaces.
+ */
+std::string CorpusGenerator::text(size_t length) {
+    std::string text(length, ' ');
+    fill(&text[0], length);
+    return text;
+}
+
+/**
+ * @brief Creates a corrupter for a profile's `malformed` fraction. It draws from its
+ * own stream, so the plaintext is the same with or without corruption.
+ */
+GlyphCorrupter::GlyphCorrupter(const CorpusProfile& profile)
+    : random(profile.seed ^ 0x5DEECE66Dull),
+      limit(profile.malformed >= 1.0 ? ~uint64_t{0} : fractionLimit(profile.malformed, 63) * 2) {}
+
+/**
+ * @brief Corrupts glyphs of a ciphertext piece in place by replacing their last byte
+ * with 0x80: ▲ and ▼ become ▀, ◆ becomes ◀. The piece must not cut a glyph.
+ */
+void GlyphCorrupter::corrupt(char* data, size_t length) {
+    if (limit == 0) return;
+
+    unsigned char* bytes = reinterpret_cast<unsigned char*>(data);
+    for (size_t i = 0; i + 2 < length;) {
+        const unsigned char second = bytes[i + 1];
+        const unsigned char third = bytes[i + 2];
+        const bool glyph = bytes[i] == 0xE2 && ((second == 0x96 && (third == 0xB2 || third == 0xBC)) ||
+                                                (second == 0x97 && third == 0x86));
+        if (!glyph) {
+            i++;
+            continue;
+        }
+
+        if (random.next() < limit) bytes[i + 2] = 0x80;
+        i += 3;
+    }
+}
+
+/**
+ * @brief Reads a byte size such as 4096, 64K, 16M or 2G (binary multiples).
+ * Signs, leading spaces and sizes that do not fit a size_t are rejected; strtoull()
+ * alone would accept them, and wrap a negative number around to a huge one.
+ *
+ * @return true If the text is a positive size.
+ */
+bool parseSize(const std::string& text, size_t& size) {
+    if (text.empty() || text[0] < '0' || text[0] > '9') return false;
+
+    char* end;
+    errno = 0;
+    const unsigned long long value = std::strtoull(text.c_str(), &end, 10);
+    if (errno == ERANGE) return false;
+
+    size_t scale = 1;
+    if (*end == 'K' || *end == 'k') scale = size_t{1} << 10;
+    if (*end == 'M' || *end == 'm') scale = size_t{1} << 20;
+    if (*end == 'G' || *end == 'g') scale = size_t{1} << 30;
+    if (scale != 1) end++;
+    if (*end) return false;
+    if (value > SIZE_MAX / scale) return false;
+
+    size = static_cast<size_t>(value) * scale;
+    return size > 0;
+}
+
+/**
+ * @brief Reads a decimal count between `least` and `most`. Signs, spaces and trailing
+ * characters are rejected, unlike atoi() and strtoull(), which stop at the first one.
+ *
+ * @return true If the text is only digits and the count is in range.
+ */
+bool parseCount(const std::string& text, uint64_t least, uint64_t most, uint64_t& count) {
+    if (text.empty() || text[0] < '0' || text[0] > '9') return false;
+
+    char* end;
+    errno = 0;
+    const unsigned long long value = std::strtoull(text.c_str(), &end, 10);
+    if (errno == ERANGE || *end || value < least || value > most) return false;
+
+    count = static_cast<uint64_t>(value);
+    return true;
+}
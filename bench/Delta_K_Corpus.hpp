@@ -0,0 +1,85 @@
+#ifndef DELTA_K_CORPUS_HPP
+#define DELTA_K_CORPUS_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+/**
+ * @brief The character mix of a synthetic corpus, as fractions of its characters.
+ *
+ * `letters` of the characters are letters, `upper` of which are uppercase; `utf8` are
+ * non-ASCII characters (2 or 3 bytes of UTF-8, never a cipher glyph); the rest are
+ * spaces, punctuation, digits and newlines in fixed proportions. `malformed` is the
+ * fraction of ciphertext glyphs that are corrupted, for decoding benchmarks.
+ */
+struct CorpusProfile {
+    double letters = 0.8;
+    double upper = 0.1;
+    double utf8 = 0.0;
+    double malformed = 0.0;
+    uint64_t seed = 1;
+};
+
+/**
+ * @brief A small, fast generator with the same output on every platform (SplitMix64),
+ * unlike the standard distributions, whose output depends on the library.
+ */
+class CorpusRandom {
+public:
+    explicit CorpusRandom(uint64_t seed) : state(seed) {}
+
+    uint64_t next() {
+        uint64_t z = (state += 0x9E3779B97F4A7C15ull);
+        z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ull;
+        z = (z ^ (z >> 27)) * 0x94D049BB133111EBull;
+        return z ^ (z >> 31);
+    }
+
+private:
+    uint64_t state;
+};
+
+/**
+ * @brief Generates plaintext from a profile, the same bytes for the same seed however
+ * the output is cut into pieces.
+ */
+class CorpusGenerator {
+public:
+    explicit CorpusGenerator(const CorpusProfile& profile);
+
+    size_t fill(char* out, size_t capacity);
+    std::string text(size_t length);
+
+private:
+    size_t nextCharacter(char* out);
+
+    CorpusRandom random;
+    uint64_t letterLimit;
+    uint64_t utf8Limit;
+    uint64_t upperLimit;
+    // A character that did not fit the last piece opens the next one.
+    char pending[4];
+    size_t pendingLength = 0;
+};
+
+/**
+ * @brief Corrupts a profile's fraction of the glyphs of ciphertext pieces, so the glyph
+ * no longer matches and its triplet is copied through instead of decoded. The
+ * corrupted glyph is still valid UTF-8.
+ */
+class GlyphCorrupter {
+public:
+    explicit GlyphCorrupter(const CorpusProfile& profile);
+
+    void corrupt(char* data, size_t length);
+
+private:
+    CorpusRandom random;
+    uint64_t limit;
+};
+
+bool parseSize(const std::string& text, size_t& size);
+bool parseCount(const std::string& text, uint64_t least, uint64_t most, uint64_t& count);
+
+#endif
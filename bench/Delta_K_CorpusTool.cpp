@@ -0,0 +1,204 @@
+/**
+ * @brief delta-k-corpus: writes a seeded synthetic corpus for reproducible benchmarks.
+ *
+ * From a character mix and a seed it streams PREFIX.txt (the plaintext), PREFIX.std.dk
+ * (its Standard Mode ciphertext) and PREFIX.key.dk (its Delta Mode ciphertext) to disk,
+ * 1 MiB at a time, so corpora of any size take constant memory. The same options give
+ * the same bytes on every machine and revision.
+ */
+
+#include "Delta_K.hpp"
+#include "Delta_K_Corpus.hpp"
+#include "Delta_K_Stream.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
+#include <string>
+#include <string_view>
+#include <vector>
+
+/**
+ * @brief The options given on the command line (see parseArguments()).
+ */
+struct CorpusOptions {
+    std::string prefix;
+    size_t size = 0;
+    CorpusProfile profile;
+    std::string key = "Kryptos";
+    bool plainOnly = false;
+};
+
+/**
+ * @brief The plaintext bytes generated (and coded) per block.
+ */
+constexpr size_t CORPUS_BLOCK = size_t{1} << 20;
+
+/**
+ * @brief Prints the command-line usage to stderr.
+ */
+static void printUsage(const char* program) {
+    std::cerr << "Usage: " << program << " -o PREFIX --size SIZE [options]" << std::endl
+              << "  -o PREFIX           write PREFIX.txt, PREFIX.std.dk and PREFIX.key.dk" << std::endl
+              << "  --size SIZE         plaintext size, e.g. 64K, 100M or 20G" << std::endl
+              << "  --letters F         fraction of letters (default: 0.8)" << std::endl
+              << "  --upper F           fraction of letters in uppercase (default: 0.1)" << std::endl
+              << "  --utf8 F            fraction of non-ASCII characters (default: 0)" << std::endl
+              << "  --malformed F       fraction of ciphertext glyphs corrupted (default: 0)" << std::endl
+              << "  --key KEY           the Delta Mode key (default: Kryptos)" << std::endl
+              << "  --seed N            the generator seed (default: 1)" << std::endl
+              << "  --plain-only        write only the plaintext" << std::endl;
+}
+
+/**
+ * @brief Reads a fraction between 0 and 1, reporting a bad one to stderr.
+ */
+static bool parseFraction(const std::string& name, const std::string& text, double& fraction) {
+    char* end;
+    fraction = std::strtod(text.c_str(), &end);
+
+    if (end == text.c_str() || *end || fraction < 0 || fraction > 1) {
+        std::cerr << "Invalid " << name << ": " << text << " (expected 0 to 1)" << std::endl;
+        return false;
+    }
+
+    return true;
+}
+
+/**
+ * @brief Reads the command line into `options`, reporting any error to stderr.
+ *
+ * @return true If every argument was understood and the prefix and size were given.
+ */
+static bool parseArguments(int argc, char* argv[], CorpusOptions& options) {
+    for (int i = 1; i < argc; i++) {
+        const std::string argument = argv[i];
+
+        if (argument == "--plain-only") {
+            options.plainOnly = true;
+            continue;
+        }
+        if (argument == "-h" || argument == "--help" || i + 1 >= argc) {
+            printUsage(argv[0]);
+            return false;
+        }
+
+        const std::string value = argv[++i];
+        bool valid = true;
+
+        if (argument == "-o") {
+            options.prefix = value;
+        } else if (argument == "--size") {
+            valid = parseSize(value, options.size);
+            if (!valid) std::cerr << "Invalid size: " << value << std::endl;
+        } else if (argument == "--letters") {
+            valid = parseFraction("fraction of letters", value, options.profile.letters);
+        } else if (argument == "--upper") {
+            valid = parseFraction("fraction of uppercase", value, options.profile.upper);
+        } else if (argument == "--utf8") {
+            valid = parseFraction("fraction of non-ASCII", value, options.profile.utf8);
+        } else if (argument == "--malformed") {
+            valid = parseFraction("fraction of malformed glyphs", value, options.profile.malformed);
+        } else if (argument == "--key") {
+            valid = keyValidation(value);
+            if (!valid) std::cerr << "Invalid key: " << value << std::endl;
+            options.key = value;
+        } else if (argument == "--seed") {
+            valid = parseCount(value, 0, UINT64_MAX, options.profile.seed);
+            if (!valid) std::cerr << "Invalid seed: " << value << std::endl;
+        } else {
+            std::cerr << "Unknown option: " << argument << std::endl;
+            printUsage(argv[0]);
+            return false;
+        }
+
+        if (!valid) return false;
+    }
+
+    if (options.prefix.empty() || options.size == 0) {
+        printUsage(argv[0]);
+        return false;
+    }
+    if (options.profile.letters + options.profile.utf8 > 1) {
+        std::cerr << "Letters and non-ASCII characters add up to more than 1" << std::endl;
+        return false;
+    }
+
+    return true;
+}
+
+/**
+ * @brief Opens an output file, reporting a failure to stderr.
+ */
+static bool openOutput(std::ofstream& out, const std::string& path) {
+    out.open(path, std::ios::binary | std::ios::trunc);
+    if (!out) std::cerr << "Cannot open " << path << " for writing" << std::endl;
+    return static_cast<bool>(out);
+}
+
+int main(int argc, char* argv[]) {
+    CorpusOptions options;
+    if (!parseArguments(argc, argv, options)) return 1;
+
+    const std::string plainPath = options.prefix + ".txt";
+    const std::string standardPath = options.prefix + ".std.dk";
+    const std::string keyedPath = options.prefix + ".key.dk";
+    std::ofstream plain, standard, keyed;
+
+    if (!openOutput(plain, plainPath)) return 1;
+    if (!options.plainOnly && (!openOutput(standard, standardPath) || !openOutput(keyed, keyedPath))) return 1;
+
+    const std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+    CorpusGenerator generator(options.profile);
+    GlyphCorrupter standardCorrupter(options.profile);
+    GlyphCorrupter keyedCorrupter(options.profile);
+    DeltaKEncoder standardEncoder;
+    DeltaKEncoder keyedEncoder(options.key);
+    std::vector<char> block(CORPUS_BLOCK);
+    std::vector<char> cipher(CORPUS_BLOCK * GLYPH_SIZE * BASE);
+    size_t remaining = options.size;
+    size_t standardBytes = 0;
+    size_t keyedBytes = 0;
+
+    while (remaining > 0) {
+        size_t length = generator.fill(block.data(), std::min(remaining, CORPUS_BLOCK));
+        // Only the last block can end short of a multi-byte character; pad it with spaces.
+        if (remaining <= CORPUS_BLOCK) {
+            std::fill(block.data() + length, block.data() + remaining, ' ');
+            length = remaining;
+        }
+        remaining -= length;
+
+        const std::string_view text(block.data(), length);
+        plain.write(block.data(), static_cast<std::streamsize>(length));
+        if (options.plainOnly) continue;
+
+        size_t written = standardEncoder.feed(text, cipher.data());
+        standardCorrupter.corrupt(cipher.data(), written);
+        standard.write(cipher.data(), static_cast<std::streamsize>(written));
+        standardBytes += written;
+
+        written = keyedEncoder.feed(text, cipher.data());
+        keyedCorrupter.corrupt(cipher.data(), written);
+        keyed.write(cipher.data(), static_cast<std::streamsize>(written));
+        keyedBytes += written;
+    }
+
+    if (!plain.flush() || (!options.plainOnly && (!standard.flush() || !keyed.flush()))) {
+        std::cerr << "Write failed" << std::endl;
+        return 1;
+    }
+
+    const double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    std::cout << plainPath << ": " << options.size << " bytes" << std::endl;
+    if (!options.plainOnly) {
+        std::cout << standardPath << ": " << standardBytes << " bytes" << std::endl
+                  << keyedPath << ": " << keyedBytes << " bytes" << std::endl;
+    }
+    std::cout << "Generated in " << seconds << " s" << std::endl;
+
+    return 0;
+}
@@ -0,0 +1,484 @@
+/**
+ * @brief delta-k-latency: per-call latency of the codec on chat-length messages.
+ *
+ * Throughput numbers hide what dominates short inputs: allocation, setup and branch
+ * mispredicts. This harness times encrypt(), keyed encrypt(), decrypt() and keyed
+ * decrypt() one call at a time on seeded messages of 20-200 characters, and records
+ * every time in a log-linear (HDR-style) histogram. Warm runs cycle through a few
+ * messages that stay in cache; cold runs walk a buffer larger than the caches before
+ * every call, so each call starts from memory.
+ */
+
+#include "Delta_K.hpp"
+#include "Delta_K_Corpus.hpp"
+#include "Delta_K_Dispatch.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <cstdlib>
+#include <fstream>
+#include <functional>
+#include <iomanip>
+#include <iostream>
+#include <string>
+#include <vector>
+
+/**
+ * @brief The options given on the command line (see parseArguments()).
+ */
+struct LatencyOptions {
+    size_t minLength = 20;
+    size_t maxLength = 200;
+    size_t messages = 4096;
+    size_t warmMessages = 16;
+    size_t warmSamples = 200000;
+    size_t coldSamples = 2000;
+    size_t evictSize = size_t{16} << 20;
+    unsigned rounds = 5;
+    std::string key = "Kryptos";
+    uint64_t seed = 1;
+    std::string cache = "both";
+    std::string json;
+};
+
+/**
+ * @brief The longest message --lengths takes, in characters.
+ */
+constexpr uint64_t MAX_MESSAGE_LENGTH = uint64_t{1} << 20;
+
+/**
+ * @brief The most messages, samples or rounds an option takes.
+ */
+constexpr uint64_t MAX_COUNT = UINT32_MAX;
+
+/**
+ * @brief A latency histogram with log-linear buckets, as in HdrHistogram.
+ *
+ * Values below 2 * SUB_BUCKETS nanoseconds have a bucket each; above that every power
+ * of two is split into SUB_BUCKETS buckets, so any value is kept to within 1/128 of
+ * itself while the histogram stays a fixed, small array.
+ */
+class LatencyHistogram {
+public:
+    static constexpr uint64_t SUB_BUCKETS = 128;
+    static constexpr int SUB_BITS = 7;
+    static constexpr int RANGES = 48;
+
+    LatencyHistogram() : counts(SUB_BUCKETS * (RANGES + 1), 0) {}
+
+    void record(uint64_t nanoseconds) {
+        counts[bucketOf(nanoseconds)]++;
+        total++;
+        sum += nanoseconds;
+        lowest = std::min(lowest, nanoseconds);
+        highest = std::max(highest, nanoseconds);
+    }
+
+    void merge(const LatencyHistogram& other) {
+        for (size_t b = 0; b < counts.size(); b++) counts[b] += other.counts[b];
+        total += other.total;
+        sum += other.sum;
+        lowest = std::min(lowest, other.lowest);
+        highest = std::max(highest, other.highest);
+    }
+
+    /**
+     * @brief Returns the value at a percentile (0-100): the upper end of the bucket that
+     * holds it, capped at the largest value recorded.
+     */
+    uint64_t percentile(double percent) const {
+        if (total == 0) return 0;
+
+        const uint64_t rank = std::max<uint64_t>(1, static_cast<uint64_t>(percent / 100.0 * total + 0.5));
+        uint64_t seen = 0;
+        for (size_t b = 0; b < counts.size(); b++) {
+            seen += counts[b];
+            if (seen >= rank) return std::min(upperBound(b), highest);
+        }
+
+        return highest;
+    }
+
+    uint64_t count() const { return total; }
+    uint64_t min() const { return total ? lowest : 0; }
+    uint64_t max() const { return highest; }
+    double mean() const { return total ? static_cast<double>(sum) / total : 0; }
+
+private:
+    static size_t bucketOf(uint64_t value) {
+        if (value < 2 * SUB_BUCKETS) return static_cast<size_t>(value);
+
+        int top = 63;
+        while (!(value >> top)) top--;
+
+        int shift = top - SUB_BITS;
+        if (shift > RANGES - 1) {
+            shift = RANGES - 1;
+            value = (2 * SUB_BUCKETS - 1) << shift;
+        }
+        return static_cast<size_t>((SUB_BUCKETS * shift) + (value >> shift));
+    }
+
+    static uint64_t upperBound(size_t bucket) {
+        if (bucket < 2 * SUB_BUCKETS) return bucket;
+
+        const int shift = static_cast<int>(bucket / SUB_BUCKETS) - 1;
+        const uint64_t sub = bucket - (SUB_BUCKETS * shift);
+        return ((sub + 1) << shift) - 1;
+    }
+
+    std::vector<uint64_t> counts;
+    uint64_t total = 0;
+    uint64_t sum = 0;
+    uint64_t lowest = UINT64_MAX;
+    uint64_t highest = 0;
+};
+
+/**
+ * @brief The percentiles reported for every run.
+ */
+static const double PERCENTILES[] = {50, 90, 99, 99.9};
+
+/**
+ * @brief One run: a function in one cache mode, with its merged histogram and the p50
+ * and p99 of every round.
+ */
+struct LatencyResult {
+    std::string function;
+    std::string mode;
+    std::string cache;
+    LatencyHistogram histogram;
+    std::vector<double> roundMedians;
+    std::vector<double> roundTails;
+};
+
+/**
+ * @brief Keeps results the compiler must not optimize away.
+ */
+static volatile size_t latencySink;
+
+/**
+ * @brief Prints the command-line usage to stderr.
+ */
+static void printUsage(const char* program) {
+    std::cerr << "Usage: " << program << " [options]" << std::endl
+              << "  --lengths MIN,MAX   message lengths in characters (default: 20,200)" << std::endl
+              << "  --messages N        distinct messages in the cold pool (default: 4096)" << std::endl
+              << "  --samples N         timed calls per warm run (default: 200000)" << std::endl
+              << "  --cold-samples N    timed calls per cold run (default: 2000)" << std::endl
+              << "  --evict-size SIZE   bytes walked before every cold call (default: 16M)" << std::endl
+              << "  --rounds N          rounds each run is split into (default: 5)" << std::endl
+              << "  --cache MODE        warm, cold or both (default: both)" << std::endl
+              << "  --key KEY           the Delta Mode key (default: Kryptos)" << std::endl
+              << "  --seed N            the message generator seed (default: 1)" << std::endl
+              << "  --json FILE         also write the results as JSON" << std::endl;
+}
+
+/**
+ * @brief Reads a count from 1 to `most`, reporting a bad one to stderr.
+ */
+template <typename Count>
+static bool parseCountOption(const std::string& name, const std::string& text, uint64_t most, Count& count) {
+    uint64_t value;
+    if (!parseCount(text, 1, most, value)) {
+        std::cerr << "Invalid " << name << ": " << text << std::endl;
+        return false;
+    }
+
+    count = static_cast<Count>(value);
+    return true;
+}
+
+/**
+ * @brief Reads the message lengths, MIN,MAX or a single length for both.
+ */
+static bool parseLengths(const std::string& text, LatencyOptions& options) {
+    const size_t comma = text.find(',');
+    const std::string least = text.substr(0, comma);
+    const std::string most = comma == std::string::npos ? least : text.substr(comma + 1);
+    uint64_t minLength;
+    uint64_t maxLength;
+
+    if (!parseCount(least, 1, MAX_MESSAGE_LENGTH, minLength) || !parseCount(most, 1, MAX_MESSAGE_LENGTH, maxLength) ||
+        maxLength < minLength) {
+        std::cerr << "Invalid lengths: " << text << std::endl;
+        return false;
+    }
+
+    options.minLength = static_cast<size_t>(minLength);
+    options.maxLength = static_cast<size_t>(maxLength);
+    return true;
+}
+
+/**
+ * @brief Reads the command line into `options`, reporting any error to stderr.
+ *
+ * @return true If every argument was understood.
+ */
+static bool parseArguments(int argc, char* argv[], LatencyOptions& options) {
+    for (int i = 1; i < argc; i++) {
+        const std::string argument = argv[i];
+
+        if (argument == "-h" || argument == "--help" || i + 1 >= argc) {
+            printUsage(argv[0]);
+            return false;
+        }
+
+        const std::string value = argv[++i];
+        if (argument == "--lengths") {
+            if (!parseLengths(value, options)) return false;
+        } else if (argument == "--messages") {
+            if (!parseCountOption("message count", value, MAX_COUNT, options.messages)) return false;
+        } else if (argument == "--samples") {
+            if (!parseCountOption("sample count", value, MAX_COUNT, options.warmSamples)) return false;
+        } else if (argument == "--cold-samples") {
+            if (!parseCountOption("sample count", value, MAX_COUNT, options.coldSamples)) return false;
+        } else if (argument == "--evict-size") {
+            if (!parseSize(value, options.evictSize)) {
+                std::cerr << "Invalid size: " << value << std::endl;
+                return false;
+            }
+        } else if (argument == "--rounds") {
+            if (!parseCountOption("round count", value, MAX_COUNT, options.rounds)) return false;
+        } else if (argument == "--cache") {
+            if (value != "warm" && value != "cold" && value != "both") {
+                std::cerr << "Invalid cache mode: " << value << std::endl;
+                return false;
+            }
+            options.cache = value;
+        } else if (argument == "--key") {
+            if (!keyValidation(value)) {
+                std::cerr << "Invalid key: " << value << std::endl;
+                return false;
+            }
+            options.key = value;
+        } else if (argument == "--seed") {
+            if (!parseCount(value, 0, UINT64_MAX, options.seed)) {
+                std::cerr << "Invalid seed: " << value << std::endl;
+                return false;
+            }
+        } else if (argument == "--json") {
+            options.json = value;
+        } else {
+            std::cerr << "Unknown option: " << argument << std::endl;
+            printUsage(argv[0]);
+            return false;
+        }
+    }
+
+    return true;
+}
+
+/**
+ * @brief Generates the message pool: chat-like text with lengths spread uniformly over
+ * the chosen range.
+ */
+static std::vector<std::string> makeMessages(const LatencyOptions& options) {
+    CorpusProfile profile;
+    profile.letters = 0.78;
+    profile.upper = 0.05;
+    profile.seed = options.seed;
+
+    CorpusGenerator generator(profile);
+    CorpusRandom lengths(options.seed + 1);
+    std::vector<std::string> messages;
+
+    for (size_t m = 0; m < options.messages; m++) {
+        const size_t span = options.maxLength - options.minLength + 1;
+        messages.push_back(generator.text(options.minLength + (lengths.next() % span)));
+    }
+
+    return messages;
+}
+
+/**
+ * @brief Walks a buffer larger than the caches, so the next call finds none of its code
+ * or data cached.
+ */
+static void evictCaches(std::vector<unsigned char>& buffer) {
+    size_t total = 0;
+    for (size_t i = 0; i < buffer.size(); i += 64) {
+        total += buffer[i]++;
+    }
+    latencySink = total;
+}
+
+/**
+ * @brief Times a call once per sample. Warm runs cycle through the first warmMessages
+ * inputs after a warm-up pass; cold runs step through the whole pool and evict the
+ * caches before every call.
+ */
+static LatencyResult runLatency(const std::string& function, const std::string& mode, bool cold,
+                                const std::vector<std::string>& inputs,
+                                const std::function<size_t(const std::string&)>& call,
+                                std::vector<unsigned char>& evictBuffer, const LatencyOptions& options) {
+    using Clock = std::chrono::steady_clock;
+
+    LatencyResult result;
+    result.function = function;
+    result.mode = mode;
+    result.cache = cold ? "cold" : "warm";
+
+    const size_t pool = cold ? inputs.size() : std::min(options.warmMessages, inputs.size());
+    const size_t samples = cold ? options.coldSamples : options.warmSamples;
+    const size_t perRound = std::max<size_t>(1, samples / options.rounds);
+
+    if (!cold) {
+        for (size_t s = 0; s < std::min<size_t>(samples, 10000); s++) latencySink = call(inputs[s % pool]);
+    }
+
+    size_t next = 0;
+    for (unsigned r = 0; r < options.rounds; r++) {
+        LatencyHistogram round;
+
+        for (size_t s = 0; s < perRound; s++) {
+            const std::string& input = inputs[next++ % pool];
+            if (cold) evictCaches(evictBuffer);
+
+            const Clock::time_point start = Clock::now();
+            latencySink = call(input);
+            const Clock::time_point end = Clock::now();
+
+            round.record(static_cast<uint64_t>(
+                std::chrono::duration_cast<std::chrono::nanoseconds>(end - start).count()));
+        }
+
+        result.roundMedians.push_back(static_cast<double>(round.percentile(50)));
+        result.roundTails.push_back(static_cast<double>(round.percentile(99)));
+        result.histogram.merge(round);
+    }
+
+    return result;
+}
+
+/**
+ * @brief Measures the cost of reading the clock twice, which every sample includes.
+ */
+static uint64_t timerOverhead() {
+    using Clock = std::chrono::steady_clock;
+    LatencyHistogram histogram;
+
+    for (int i = 0; i < 10000; i++) {
+        const Clock::time_point start = Clock::now();
+        const Clock::time_point end = Clock::now();
+        histogram.record(
+            static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(end - start).count()));
+    }
+
+    return histogram.percentile(50);
+}
+
+/**
+ * @brief Prints the results as a table, in nanoseconds.
+ */
+static void printTable(const std::vector<LatencyResult>& results) {
+    std::cout << std::left << std::setw(10) << "function" << std::setw(10) << "mode" << std::setw(7) << "cache"
+              << std::right << std::setw(9) << "samples" << std::setw(8) << "min" << std::setw(8) << "p50"
+              << std::setw(8) << "p90" << std::setw(8) << "p99" << std::setw(8) << "p99.9" << std::setw(9) << "max"
+              << std::setw(9) << "mean" << std::endl;
+
+    for (const LatencyResult& result : results) {
+        const LatencyHistogram& histogram = result.histogram;
+        std::cout << std::left << std::setw(10) << result.function << std::setw(10) << result.mode << std::setw(7)
+                  << result.cache << std::right << std::setw(9) << histogram.count() << std::setw(8)
+                  << histogram.min();
+        for (double percent : PERCENTILES) {
+            std::cout << std::setw(8) << histogram.percentile(percent);
+        }
+        std::cout << std::setw(9) << histogram.max() << std::fixed << std::setprecision(1) << std::setw(9)
+                  << histogram.mean() << std::defaultfloat << std::endl;
+    }
+}
+
+/**
+ * @brief Writes one JSON record in the delta-k-bench result format, with a round's
+ * percentile as each sample.
+ */
+static void writeRecord(std::ostream& out, const LatencyResult& result, const char* statistic,
+                        const std::vector<double>& samples, double value, bool first) {
+    out << (first ? "" : ",") << "\n    {\"name\": \"latency/" << result.function << "/" << result.mode << "/"
+        << result.cache << "/" << statistic << "\", \"function\": \"" << result.function << "\", \"mode\": \""
+        << result.mode << "\", \"cache\": \"" << result.cache << "\", \"statistic\": \"" << statistic
+        << "\", \"median_ns\": " << value << ", \"samples_ns\": [";
+    for (size_t s = 0; s < samples.size(); s++) {
+        out << (s ? ", " : "") << samples[s];
+    }
+    out << "]}";
+}
+
+/**
+ * @brief Writes the results as JSON: per run, its p50 and p99 with the value of every
+ * round as samples, so delta-k-bench-compare can compare them.
+ *
+ * @return true If the file was written.
+ */
+static bool writeJson(const std::string& path, const std::vector<LatencyResult>& results, uint64_t overhead,
+                      const LatencyOptions& options) {
+    std::ofstream out(path);
+    if (!out) {
+        std::cerr << "Cannot open " << path << " for writing" << std::endl;
+        return false;
+    }
+
+    out << "{\n  \"tool\": \"delta-k-latency\",\n  \"format\": 1,\n";
+    out << "  \"tier\": \"" << tierName(activeKernels().tier) << "\",\n  \"timer_overhead_ns\": " << overhead
+        << ",\n  \"min_length\": " << options.minLength << ",\n  \"max_length\": " << options.maxLength
+        << ",\n  \"seed\": " << options.seed << ",\n  \"results\": [";
+
+    bool first = true;
+    for (const LatencyResult& result : results) {
+        writeRecord(out, result, "p50", result.roundMedians, static_cast<double>(result.histogram.percentile(50)),
+                    first);
+        writeRecord(out, result, "p99", result.roundTails, static_cast<double>(result.histogram.percentile(99)),
+                    false);
+        first = false;
+    }
+
+    out << "\n  ]\n}\n";
+    return static_cast<bool>(out.flush());
+}
+
+int main(int argc, char* argv[]) {
+    LatencyOptions options;
+    if (!parseArguments(argc, argv, options)) return 1;
+
+    const std::vector<std::string> messages = makeMessages(options);
+    std::vector<std::string> standard, keyed;
+    for (const std::string& message : messages) {
+        standard.push_back(encrypt(message));
+        keyed.push_back(encrypt(message, options.key));
+    }
+
+    const std::string& key = options.key;
+    std::vector<unsigned char> evictBuffer(options.evictSize);
+    std::vector<LatencyResult> results;
+    std::vector<bool> modes;
+    if (options.cache != "cold") modes.push_back(false);
+    if (options.cache != "warm") modes.push_back(true);
+
+    for (bool cold : modes) {
+        results.push_back(runLatency("encrypt", "standard", cold, messages,
+                                     [](const std::string& text) { return encrypt(text).size(); }, evictBuffer,
+                                     options));
+        results.push_back(runLatency("encrypt", "keyed", cold, messages,
+                                     [&key](const std::string& text) { return encrypt(text, key).size(); },
+                                     evictBuffer, options));
+        results.push_back(runLatency("decrypt", "standard", cold, standard,
+                                     [](const std::string& text) { return decrypt(text).size(); }, evictBuffer,
+                                     options));
+        results.push_back(runLatency("decrypt", "keyed", cold, keyed,
+                                     [&key](const std::string& text) { return decrypt(text, key).size(); },
+                                     evictBuffer, options));
+    }
+
+    const uint64_t overhead = timerOverhead();
+    std::cout << "Tier " << tierName(activeKernels().tier) << ", messages of " << options.minLength << "-"
+              << options.maxLength << " characters, timer overhead " << overhead << " ns (included below)"
+              << std::endl;
+    printTable(results);
+
+    if (!options.json.empty() && !writeJson(options.json, results, overhead, options)) return 1;
+
+    return 0;
+}
@@ -0,0 +1,469 @@
+/**
+ * @brief delta-k-sweep: how the parallel codec paths scale with threads, input size and
+ * chunk size.
+ *
+ * For every combination it times encryptParallel()/decryptParallel() (whole input in
+ * memory) and encryptPipelined()/decryptPipelined() (streamed in chunks), and prints a
+ * CSV row with the throughput, the speed-up over one thread and the parallel efficiency.
+ * A multi-threaded memcpy of the same size is measured alongside as the memory
+ * bandwidth ceiling: a path whose bytes moved per second approach it is bandwidth-bound,
+ * and more threads will not help it.
+ */
+
+#include "Delta_K.hpp"
+#include "Delta_K_Corpus.hpp"
+#include "Delta_K_Parallel.hpp"
+#include "Delta_K_Pipeline.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <map>
+#include <sstream>
+#include <streambuf>
+#include <string>
+#include <thread>
+#include <tuple>
+#include <vector>
+
+/**
+ * @brief The options given on the command line (see parseArguments()).
+ */
+struct SweepOptions {
+    std::vector<unsigned> threads;
+    std::vector<size_t> sizes = {4 * 1024, 256 * 1024, 16 * 1024 * 1024};
+    std::vector<size_t> chunkSizes = {256 * 1024, 1024 * 1024, 4 * 1024 * 1024};
+    std::vector<std::string> paths = {"parallel", "pipeline", "memcpy"};
+    std::vector<std::string> directions = {"encrypt", "decrypt"};
+    std::string key = "Kryptos";
+    size_t maxMemory = size_t{1} << 30;
+    unsigned repetitions = 3;
+    uint64_t seed = 1;
+    std::string csv;
+};
+
+/**
+ * @brief The most threads --threads takes, as for delta-k -j.
+ */
+constexpr uint64_t MAX_THREADS = 1024;
+
+/**
+ * @brief The most timed runs --repetitions takes per point.
+ */
+constexpr uint64_t MAX_REPETITIONS = 1000000;
+
+/**
+ * @brief The bytes of generated text (and its ciphertext) that inputs repeat.
+ */
+constexpr size_t TEMPLATE_SIZE = size_t{4} << 20;
+
+/**
+ * @brief One timed configuration. `chunkSize` is 0 for paths without chunks.
+ */
+struct SweepPoint {
+    std::string path;
+    std::string direction;
+    size_t size = 0;
+    size_t chunkSize = 0;
+    unsigned threads = 0;
+    size_t bytesOut = 0;
+    double seconds = 0;
+};
+
+/**
+ * @brief An input stream over a template repeated up to a given length, so the pipeline
+ * can stream inputs of any size from constant memory.
+ */
+class RepeatingSource : public std::streambuf {
+public:
+    RepeatingSource(const std::string& pattern, size_t length) : pattern(pattern), remaining(length) {}
+
+protected:
+    int_type underflow() override {
+        if (gptr() < egptr()) return traits_type::to_int_type(*gptr());
+        if (remaining == 0) return traits_type::eof();
+
+        const size_t length = std::min(remaining, pattern.size());
+        char* start = const_cast<char*>(pattern.data());
+        setg(start, start, start + length);
+        remaining -= length;
+
+        return traits_type::to_int_type(*gptr());
+    }
+
+private:
+    const std::string& pattern;
+    size_t remaining;
+};
+
+/**
+ * @brief An output stream that counts and drops what it is given, so the sweep measures
+ * the codec rather than a sink.
+ */
+class DiscardSink : public std::streambuf {
+public:
+    size_t written = 0;
+
+protected:
+    std::streamsize xsputn(const char*, std::streamsize count) override {
+        written += static_cast<size_t>(count);
+        return count;
+    }
+
+    int_type overflow(int_type c) override {
+        if (!traits_type::eq_int_type(c, traits_type::eof())) written++;
+        return traits_type::not_eof(c);
+    }
+};
+
+/**
+ * @brief Splits a comma-separated list.
+ */
+static std::vector<std::string> splitList(const std::string& text) {
+    std::vector<std::string> items;
+    std::stringstream stream(text);
+    std::string item;
+
+    while (std::getline(stream, item, ',')) {
+        if (!item.empty()) items.push_back(item);
+    }
+
+    return items;
+}
+
+/**
+ * @brief Reads a list of sizes, reporting a bad one to stderr.
+ */
+static bool parseSizes(const std::string& text, std::vector<size_t>& sizes) {
+    sizes.clear();
+    for (const std::string& item : splitList(text)) {
+        size_t size;
+        if (!parseSize(item, size)) {
+            std::cerr << "Invalid size: " << item << std::endl;
+            return false;
+        }
+        sizes.push_back(size);
+    }
+
+    return !sizes.empty();
+}
+
+/**
+ * @brief Reads a list of names that must all be among `allowed`, reporting an unknown
+ * one to stderr.
+ */
+static bool parseChoices(const std::string& name, const std::string& text, const std::vector<std::string>& allowed,
+                         std::vector<std::string>& items) {
+    items = splitList(text);
+    for (const std::string& item : items) {
+        if (std::find(allowed.begin(), allowed.end(), item) == allowed.end()) {
+            std::cerr << "Unknown " << name << ": " << item << std::endl;
+            return false;
+        }
+    }
+    if (items.empty()) {
+        std::cerr << "No " << name << " given" << std::endl;
+        return false;
+    }
+
+    return true;
+}
+
+/**
+ * @brief Prints the command-line usage to stderr.
+ */
+static void printUsage(const char* program) {
+    std::cerr << "Usage: " << program << " [options]" << std::endl
+              << "  --threads LIST      thread counts (default: 1, 2, 4, ... up to the core count)" << std::endl
+              << "  --sizes LIST        input sizes, e.g. 4K,256K,16M (default) up to 16G" << std::endl
+              << "  --chunks LIST       pipeline chunk sizes (default: 256K,1M,4M)" << std::endl
+              << "  --paths LIST        parallel, pipeline, memcpy (default: all)" << std::endl
+              << "  --directions LIST   encrypt, decrypt (default: both)" << std::endl
+              << "  --key KEY           the Delta Mode key; 0 for Standard Mode (default: Kryptos)" << std::endl
+              << "  --max-memory SIZE   largest input the in-memory paths take (default: 1G)" << std::endl
+              << "  --repetitions N     timed runs per point; the fastest is kept (default: 3)" << std::endl
+              << "  --seed N            the input generator seed (default: 1)" << std::endl
+              << "  --csv FILE          write the CSV to a file instead of stdout" << std::endl;
+}
+
+/**
+ * @brief Reads the command line into `options`, reporting any error to stderr.
+ *
+ * @return true If every argument was understood.
+ */
+static bool parseArguments(int argc, char* argv[], SweepOptions& options) {
+    for (int i = 1; i < argc; i++) {
+        const std::string argument = argv[i];
+
+        if (argument == "-h" || argument == "--help" || i + 1 >= argc) {
+            printUsage(argv[0]);
+            return false;
+        }
+
+        const std::string value = argv[++i];
+        if (argument == "--threads") {
+            options.threads.clear();
+            for (const std::string& item : splitList(value)) {
+                uint64_t threads;
+                if (!parseCount(item, 1, MAX_THREADS, threads)) {
+                    std::cerr << "Invalid thread count: " << item << std::endl;
+                    return false;
+                }
+                options.threads.push_back(static_cast<unsigned>(threads));
+            }
+        } else if (argument == "--sizes") {
+            if (!parseSizes(value, options.sizes)) return false;
+        } else if (argument == "--chunks") {
+            if (!parseSizes(value, options.chunkSizes)) return false;
+        } else if (argument == "--paths") {
+            if (!parseChoices("path", value, SweepOptions().paths, options.paths)) return false;
+        } else if (argument == "--directions") {
+            if (!parseChoices("direction", value, SweepOptions().directions, options.directions)) return false;
+        } else if (argument == "--key") {
+            if (value != "0" && !keyValidation(value)) {
+                std::cerr << "Invalid key: " << value << std::endl;
+                return false;
+            }
+            options.key = value == "0" ? "" : value;
+        } else if (argument == "--max-memory") {
+            if (!parseSize(value, options.maxMemory)) {
+                std::cerr << "Invalid size: " << value << std::endl;
+                return false;
+            }
+        } else if (argument == "--repetitions") {
+            uint64_t repetitions;
+            if (!parseCount(value, 1, MAX_REPETITIONS, repetitions)) {
+                std::cerr << "Invalid repetition count: " << value << std::endl;
+                return false;
+            }
+            options.repetitions = static_cast<unsigned>(repetitions);
+        } else if (argument == "--seed") {
+            if (!parseCount(value, 0, UINT64_MAX, options.seed)) {
+                std::cerr << "Invalid seed: " << value << std::endl;
+                return false;
+            }
+        } else if (argument == "--csv") {
+            options.csv = value;
+        } else {
+            std::cerr << "Unknown option: " << argument << std::endl;
+            printUsage(argv[0]);
+            return false;
+        }
+    }
+
+    if (options.threads.empty()) {
+        const unsigned cores = defaultThreadCount();
+        for (unsigned t = 1; t < cores; t *= 2) options.threads.push_back(t);
+        options.threads.push_back(cores);
+    }
+    std::sort(options.threads.begin(), options.threads.end());
+    options.threads.erase(std::unique(options.threads.begin(), options.threads.end()), options.threads.end());
+
+    return true;
+}
+
+/**
+ * @brief Repeats a template up to `length` bytes.
+ */
+static std::string repeatTo(const std::string& pattern, size_t length) {
+    std::string text(length, ' ');
+    for (size_t i = 0; i < length; i += pattern.size()) {
+        std::memcpy(&text[i], pattern.data(), std::min(pattern.size(), length - i));
+    }
+    return text;
+}
+
+/**
+ * @brief Runs a timed call `repetitions` times and keeps the fastest, which is the one
+ * least disturbed by the rest of the system.
+ *
+ * @param call Returns the number of output bytes.
+ */
+template <typename Call>
+static double fastest(const Call& call, unsigned repetitions, size_t& bytesOut) {
+    using Clock = std::chrono::steady_clock;
+    double best = 0;
+
+    for (unsigned r = 0; r < repetitions; r++) {
+        const Clock::time_point start = Clock::now();
+        bytesOut = call();
+        const double seconds = std::chrono::duration<double>(Clock::now() - start).count();
+        if (r == 0 || seconds < best) best = seconds;
+    }
+
+    return best;
+}
+
+/**
+ * @brief Copies `length` bytes with `threads` threads, each taking an equal slice.
+ */
+static size_t parallelCopy(char* to, const char* from, size_t length, unsigned threads) {
+    std::vector<std::thread> workers;
+    const size_t slice = (length + threads - 1) / threads;
+
+    for (unsigned t = 1; t < threads; t++) {
+        const size_t begin = std::min(length, t * slice);
+        const size_t end = std::min(length, begin + slice);
+        workers.emplace_back([=] { std::memcpy(to + begin, from + begin, end - begin); });
+    }
+    std::memcpy(to, from, std::min(length, slice));
+
+    for (std::thread& worker : workers) worker.join();
+    return length;
+}
+
+/**
+ * @brief Times every point of the sweep and returns them in order.
+ */
+static std::vector<SweepPoint> runSweep(const SweepOptions& options) {
+    CorpusProfile profile;
+    profile.seed = options.seed;
+
+    const std::string plainTemplate = CorpusGenerator(profile).text(TEMPLATE_SIZE);
+    const std::string cipherTemplate = encrypt(plainTemplate, options.key);
+    const std::string& key = options.key;
+    std::vector<SweepPoint> points;
+
+    auto has = [](const std::vector<std::string>& list, const char* item) {
+        return std::find(list.begin(), list.end(), item) != list.end();
+    };
+
+    for (size_t size : options.sizes) {
+        const bool inMemory = size <= options.maxMemory;
+        if (!inMemory && (has(options.paths, "parallel") || has(options.paths, "memcpy"))) {
+            std::cerr << "Size " << size << " is above --max-memory; only the pipeline runs it" << std::endl;
+        }
+
+        for (const std::string& direction : options.directions) {
+            const bool encrypting = direction == "encrypt";
+            const std::string& pattern = encrypting ? plainTemplate : cipherTemplate;
+            const std::string input = inMemory && has(options.paths, "parallel") ? repeatTo(pattern, size) : "";
+
+            for (unsigned threads : options.threads) {
+                SweepPoint point;
+                point.direction = direction;
+                point.size = size;
+                point.threads = threads;
+
+                if (inMemory && has(options.paths, "parallel")) {
+                    point.path = "parallel";
+                    point.seconds = fastest(
+                        [&] {
+                            return encrypting ? encryptParallel(input, key, threads).size()
+                                              : decryptParallel(input, key, threads).size();
+                        },
+                        options.repetitions, point.bytesOut);
+                    points.push_back(point);
+                }
+
+                if (has(options.paths, "pipeline")) {
+                    for (size_t chunkSize : options.chunkSizes) {
+                        PipelineOptions shape;
+                        shape.workers = threads;
+                        shape.chunkSize = chunkSize;
+
+                        point.path = "pipeline";
+                        point.chunkSize = chunkSize;
+                        point.seconds = fastest(
+                            [&] {
+                                RepeatingSource source(pattern, size);
+                                DiscardSink sink;
+                                std::istream in(&source);
+                                std::ostream out(&sink);
+                                if (encrypting) {
+                                    encryptPipelined(in, out, key, shape);
+                                } else {
+                                    decryptPipelined(in, out, key, shape);
+                                }
+                                return sink.written;
+                            },
+                            options.repetitions, point.bytesOut);
+                        points.push_back(point);
+                    }
+                    point.chunkSize = 0;
+                }
+            }
+        }
+
+        if (inMemory && has(options.paths, "memcpy")) {
+            const std::string from = repeatTo(plainTemplate, size);
+            std::string to(size, ' ');
+
+            for (unsigned threads : options.threads) {
+                SweepPoint point;
+                point.path = "memcpy";
+                point.direction = "copy";
+                point.size = size;
+                point.threads = threads;
+                point.seconds = fastest([&] { return parallelCopy(&to[0], from.data(), size, threads); },
+                                        options.repetitions, point.bytesOut);
+                points.push_back(point);
+            }
+        }
+    }
+
+    return points;
+}
+
+/**
+ * @brief Writes the sweep as CSV. The speed-up and efficiency of a point compare it with
+ * the same path, direction, size and chunk size on the fewest threads swept; the
+ * bandwidth share compares its bytes moved (in plus out) per second with the fastest
+ * memcpy of the same size, on any thread count.
+ */
+static void writeCsv(std::ostream& out, const std::vector<SweepPoint>& points) {
+    using Series = std::tuple<std::string, std::string, size_t, size_t>;
+    std::map<Series, const SweepPoint*> base;
+    std::map<size_t, double> copyRate;
+
+    for (const SweepPoint& point : points) {
+        const Series series(point.path, point.direction, point.size, point.chunkSize);
+        if (!base.count(series) || point.threads < base[series]->threads) base[series] = &point;
+        if (point.path == "memcpy") {
+            double& rate = copyRate[point.size];
+            rate = std::max(rate, 2.0 * static_cast<double>(point.size) / point.seconds);
+        }
+    }
+
+    out << "path,direction,size,chunk_size,threads,seconds,mb_per_s_in,mb_per_s_out,speedup,efficiency,"
+           "bandwidth_share"
+        << std::endl;
+
+    for (const SweepPoint& point : points) {
+        const SweepPoint& reference = *base[Series(point.path, point.direction, point.size, point.chunkSize)];
+        const double speedup = point.seconds > 0 ? reference.seconds / point.seconds : 0;
+        const double efficiency = speedup * reference.threads / point.threads;
+        const double moved = static_cast<double>(point.size + point.bytesOut) / point.seconds;
+        const auto copy = copyRate.find(point.size);
+
+        out << point.path << "," << point.direction << "," << point.size << "," << point.chunkSize << ","
+            << point.threads << "," << point.seconds << "," << (point.size / point.seconds / 1e6) << ","
+            << (point.bytesOut / point.seconds / 1e6) << "," << speedup << "," << efficiency << ",";
+        if (copy != copyRate.end()) out << (moved / copy->second);
+        out << std::endl;
+    }
+}
+
+int main(int argc, char* argv[]) {
+    SweepOptions options;
+    if (!parseArguments(argc, argv, options)) return 1;
+
+    const std::vector<SweepPoint> points = runSweep(options);
+
+    if (options.csv.empty()) {
+        writeCsv(std::cout, points);
+        return 0;
+    }
+
+    std::ofstream out(options.csv);
+    if (!out) {
+        std::cerr << "Cannot open " << options.csv << " for writing" << std::endl;
+        return 1;
+    }
+    writeCsv(out, points);
+
+    return out ? 0 : 1;
+}
@@ -1,7 +1,12 @@
 #ifndef DELTA_K_HPP
 #define DELTA_K_HPP
 
+#include "Delta_K_Key.hpp"
+
+#include <algorithm>
+#include <cstddef>
 #include <string>
+#include <string_view>
 
 /**
  * @brief The length of the standard alphabet (A-Z).
@@ -38,15 +43,88 @@ const int TRIT_ALPHABET[ALPHABET_LENGTH][BASE] = {
 // Main encoder function
 std::string encrypt(const std::string& plaintext);
 std::string encrypt(const std::string& plaintext, const std::string& key);
+std::string encrypt(const std::string& plaintext, const DeltaKey& key);
 
 // Main decoder function
 std::string decrypt(const std::string& ciphertext);
+std::string decrypt(const std::string& ciphertext, const std::string& key);
+std::string decrypt(const std::string& ciphertext, const DeltaKey& key);
+
+// Size queries
+size_t encodedSize(std::string_view plaintext);
+size_t decodedSize(std::string_view ciphertext);
+
+// Caller-buffer encoder/decoder functions (no allocation)
+size_t encryptInto(std::string_view plaintext, char* out);
+size_t encryptInto(std::string_view plaintext, std::string_view key, char* out);
+size_t encryptInto(std::string_view plaintext, const DeltaKey& key, char* out);
+size_t decryptInto(std::string_view ciphertext, char* out);
+size_t decryptInto(std::string_view ciphertext, std::string_view key, char* out);
+size_t decryptInto(std::string_view ciphertext, const DeltaKey& key, char* out);
+
+/**
+ * @brief Receives output in pieces: `sink` is the caller's context, passed back as is.
+ */
+using SinkWriter = void (*)(void* sink, const char* data, size_t length);
+
+// Sink encoder/decoder functions
+void encryptToSink(std::string_view plaintext, std::string_view key, SinkWriter write, void* sink);
+void decryptToSink(std::string_view ciphertext, std::string_view key, SinkWriter write, void* sink);
+
+/**
+ * @brief The SinkWriter behind encryptTo() and decryptTo(): copies each piece to the
+ * output iterator that `sink` points at, and moves the iterator on.
+ */
+template <typename OutputIt>
+void writeToIterator(void* sink, const char* data, size_t length) {
+    OutputIt& out = *static_cast<OutputIt*>(sink);
+    out = std::copy(data, data + length, out);
+}
+
+/**
+ * @brief Encrypts straight into an output iterator, e.g. std::back_inserter(buffer) or
+ * std::ostreambuf_iterator<char>(stream), a few KiB at a time without allocating.
+ *
+ * @param plaintext The source text.
+ * @param key The keyword, or empty for Standard Mode.
+ * @param out Where the ciphertext goes.
+ * @return OutputIt The iterator past the last byte written.
+ */
+template <typename OutputIt>
+OutputIt encryptTo(std::string_view plaintext, std::string_view key, OutputIt out) {
+    encryptToSink(plaintext, key, &writeToIterator<OutputIt>, &out);
+    return out;
+}
+
+template <typename OutputIt>
+OutputIt encryptTo(std::string_view plaintext, OutputIt out) {
+    return encryptTo(plaintext, std::string_view(), out);
+}
+
+/**
+ * @brief Decrypts straight into an output iterator (see encryptTo()).
+ *
+ * @param ciphertext The glyph text.
+ * @param key The keyword it was encrypted with, or empty for Standard Mode.
+ * @param out Where the plaintext goes.
+ * @return OutputIt The iterator past the last byte written.
+ */
+template <typename OutputIt>
+OutputIt decryptTo(std::string_view ciphertext, std::string_view key, OutputIt out) {
+    decryptToSink(ciphertext, key, &writeToIterator<OutputIt>, &out);
+    return out;
+}
+
+template <typename OutputIt>
+OutputIt decryptTo(std::string_view ciphertext, OutputIt out) {
+    return decryptTo(ciphertext, std::string_view(), out);
+}
 
 // Helper function(s)
 int abcPosition(char abc);
 bool keyValidation(const std::string& key);
-bool isGlyph(std::string c);
-int glyphVal(std::string c);
+bool isGlyph(const std::string& c);
+int glyphVal(const std::string& c);
 int abcSearch(int a, int b, int c);
 
 #endif
\ No newline at end of file
@@ -0,0 +1,31 @@
+#ifndef DELTA_K_ASYNC_IO_HPP
+#define DELTA_K_ASYNC_IO_HPP
+
+#include <cstddef>
+#include <string>
+
+/**
+ * @brief How the asynchronous file pipeline talks to the disk: io_uring, or plain
+ * pread()/pwrite() calls (used automatically when io_uring cannot be set up). The
+ * pread() backend runs each transfer synchronously, so it does not overlap I/O with coding.
+ */
+enum class IoBackend { Uring, Pread };
+
+/**
+ * @brief The shape of the asynchronous file pipeline.
+ * `depth` blocks of `blockSize` bytes are in flight at once, each with its own buffers.
+ */
+struct AsyncOptions {
+    IoBackend backend = IoBackend::Uring;
+    unsigned depth = 4;
+    size_t blockSize = size_t{1} << 20;
+};
+
+// Asynchronous file codec
+bool uringAvailable();
+bool encryptFileAsync(const std::string& inputPath, const std::string& outputPath, const std::string& key,
+                      const AsyncOptions& options = AsyncOptions());
+bool decryptFileAsync(const std::string& inputPath, const std::string& outputPath, const std::string& key,
+                      const AsyncOptions& options = AsyncOptions());
+
+#endif
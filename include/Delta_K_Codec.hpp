@@ -0,0 +1,54 @@
+#ifndef DELTA_K_CODEC_HPP
+#define DELTA_K_CODEC_HPP
+
+#include "Delta_K_Key.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <vector>
+
+/**
+ * @brief A reusable encrypt()/decrypt() for callers that code many messages with a
+ * small set of keys.
+ *
+ * The codec keeps its output buffer from call to call. The buffer grows when a message
+ * needs more room and shrinks only after a long run of much smaller messages, so an
+ * occasional large message does not cause a reallocation on every call. Keys are
+ * compiled once (see DeltaKey) and kept in a small least-recently-used cache.
+ * Once the buffer and the cache have warmed up, encrypt() and decrypt() allocate
+ * nothing.
+ */
+class DeltaKCodec {
+public:
+    explicit DeltaKCodec(size_t keySlots = 8);
+
+    std::string_view encrypt(std::string_view plaintext, std::string_view key = std::string_view());
+    std::string_view decrypt(std::string_view ciphertext, std::string_view key = std::string_view());
+
+    size_t capacity() const { return outputCapacity; }
+    void release();
+
+private:
+    struct CompiledKey {
+        std::string text;
+        DeltaKey key;
+        uint64_t lastUse = 0;
+    };
+
+    const CompiledKey& compile(std::string_view key);
+    unsigned char* reserve(size_t length);
+
+    std::vector<CompiledKey> keys;
+    size_t keySlots;
+    uint64_t clock = 0;
+
+    std::unique_ptr<unsigned char[]> output;
+    size_t outputCapacity = 0;
+    size_t smallCalls = 0;
+    size_t smallPeak = 0;
+};
+
+#endif
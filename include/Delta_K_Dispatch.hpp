@@ -0,0 +1,46 @@
+#ifndef DELTA_K_DISPATCH_HPP
+#define DELTA_K_DISPATCH_HPP
+
+#include <cstddef>
+#include <string>
+
+/**
+ * @brief The kernel tiers, from the per-character engines up to AVX-512 VBMI2.
+ * Higher tiers are faster, and a tier is only ever selected if the host supports it.
+ */
+enum class KernelTier { Scalar, SWAR, SSE42, AVX2, AVX512 };
+
+using CountKernel = size_t (*)(const unsigned char* in, size_t length);
+using DecodeKernel = size_t (*)(const unsigned char* in, size_t length, unsigned char* out);
+using EncodeKernel = size_t (*)(const unsigned char* in, size_t length, unsigned char* out);
+using KeyedKernel = size_t (*)(const unsigned char* in, size_t length, const unsigned char* key, size_t keyLength,
+                               size_t keyIndex, unsigned char* out);
+
+/**
+ * @brief The codec functions bound for one tier.
+ * A tier without its own kernel for a function borrows the one from the tier below it.
+ */
+struct KernelSet {
+    KernelTier tier;
+    CountKernel countLetters;
+    EncodeKernel encodeStandard;
+    KeyedKernel encodeKeyed;
+    DecodeKernel decodeStandard;
+    KeyedKernel decodeKeyed;
+};
+
+/**
+ * @brief The environment variable that forces a tier (see parseTier() for the names).
+ */
+constexpr const char* TIER_ENVIRONMENT = "DELTA_K_TIER";
+
+// Runtime CPU dispatch
+const char* tierName(KernelTier tier);
+bool parseTier(const std::string& name, KernelTier& tier);
+bool tierSupported(KernelTier tier);
+KernelTier bestTier();
+KernelSet kernelsFor(KernelTier tier);
+const KernelSet& activeKernels();
+bool selectTier(KernelTier tier);
+
+#endif
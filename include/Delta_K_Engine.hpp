@@ -0,0 +1,39 @@
+#ifndef DELTA_K_ENGINE_HPP
+#define DELTA_K_ENGINE_HPP
+
+#include "Delta_K.hpp"
+
+#include <cstddef>
+
+/**
+ * @brief Checks if a raw byte is an ASCII letter (A-Z or a-z) without branching.
+ * Folding to lowercase and subtracting 'a' leaves exactly the letters below 26.
+ */
+inline bool isLetterByte(unsigned char c) {
+    return static_cast<unsigned char>((c | 0x20) - 'a') < ALPHABET_LENGTH;
+}
+
+// Table-driven encoder engine
+size_t countLetters(const unsigned char* in, size_t length);
+size_t standardEncodedSize(const unsigned char* in, size_t length);
+size_t encodeStandard(const unsigned char* in, size_t length, unsigned char* out);
+size_t encodeKeyed(const unsigned char* in, size_t length, const unsigned char* key, size_t keyLength,
+                   size_t keyIndex, unsigned char* out);
+
+// Byte-level decoder engine
+size_t decodeStandard(const unsigned char* in, size_t length, unsigned char* out);
+size_t decodeKeyed(const unsigned char* in, size_t length, const unsigned char* key, size_t keyLength,
+                   size_t keyIndex, unsigned char* out);
+size_t countTriplets(const unsigned char* in, size_t length);
+size_t decodableLength(const unsigned char* in, size_t length);
+
+// SWAR engine (portable, 8 bytes per 64-bit word)
+size_t countLettersSWAR(const unsigned char* in, size_t length);
+size_t encodeStandardSWAR(const unsigned char* in, size_t length, unsigned char* out);
+size_t encodeKeyedSWAR(const unsigned char* in, size_t length, const unsigned char* key, size_t keyLength,
+                       size_t keyIndex, unsigned char* out);
+size_t decodeStandardSWAR(const unsigned char* in, size_t length, unsigned char* out);
+size_t decodeKeyedSWAR(const unsigned char* in, size_t length, const unsigned char* key, size_t keyLength,
+                       size_t keyIndex, unsigned char* out);
+
+#endif
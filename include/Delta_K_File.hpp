@@ -0,0 +1,22 @@
+#ifndef DELTA_K_FILE_HPP
+#define DELTA_K_FILE_HPP
+
+#include <string>
+
+/**
+ * @brief Kernel hints for the mappings of a memory-mapped encode or decode.
+ * Both are advisory; a kernel that ignores them only loses speed.
+ */
+struct MapHints {
+    bool sequential = true;
+    bool hugePages = false;
+};
+
+// Memory-mapped file codec
+bool mappedFilesAvailable();
+bool encryptMappedFile(const std::string& inputPath, const std::string& outputPath, const std::string& key,
+                       const MapHints& hints = MapHints(), unsigned threads = 0);
+bool decryptMappedFile(const std::string& inputPath, const std::string& outputPath, const std::string& key,
+                       const MapHints& hints = MapHints(), unsigned threads = 0);
+
+#endif
@@ -0,0 +1,240 @@
+#ifndef DELTA_K_KERNELS_HPP
+#define DELTA_K_KERNELS_HPP
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+
+#if defined(_MSC_VER) && !defined(__clang__)
+#include <intrin.h>
+#endif
+
+#if defined(__x86_64__) || defined(_M_X64) || defined(__i386__) || defined(_M_IX86)
+#define DELTA_K_X86 1
+#endif
+
+/**
+ * @brief Marks a single function as compiled for a given instruction set.
+ *
+ * SIMD kernels are compiled per function rather than per file, so the rest of the
+ * program (including any inline helpers a kernel file pulls in) keeps the baseline
+ * instruction set and the same binary still runs on older hosts.
+ */
+#if defined(DELTA_K_X86) && (defined(__GNUC__) || defined(__clang__))
+#define DELTA_K_TARGET(isa) __attribute__((target(isa)))
+#else
+#define DELTA_K_TARGET(isa)
+#endif
+
+/**
+ * @brief Returns the index of the lowest set bit of a non-zero mask.
+ */
+inline unsigned countTrailingZeros(unsigned int bits) {
+#if defined(_MSC_VER) && !defined(__clang__)
+    unsigned long index;
+    _BitScanForward(&index, bits);
+    return static_cast<unsigned>(index);
+#else
+    return static_cast<unsigned>(__builtin_ctz(bits));
+#endif
+}
+
+/**
+ * @brief Returns the index of the lowest set bit of a non-zero 64-bit mask.
+ */
+inline unsigned countTrailingZeros64(uint64_t bits) {
+#if defined(_MSC_VER) && !defined(__clang__) && defined(_M_X64)
+    unsigned long index;
+    _BitScanForward64(&index, bits);
+    return static_cast<unsigned>(index);
+#elif defined(_MSC_VER) && !defined(__clang__)
+    const unsigned low = static_cast<unsigned>(bits);
+    return low ? countTrailingZeros(low) : 32 + countTrailingZeros(static_cast<unsigned>(bits >> 32));
+#else
+    return static_cast<unsigned>(__builtin_ctzll(bits));
+#endif
+}
+
+/**
+ * @brief Returns the number of set bits in a mask.
+ */
+inline unsigned countBits(unsigned int bits) {
+#if defined(_MSC_VER) && !defined(__clang__)
+    return static_cast<unsigned>(__popcnt(bits));
+#else
+    return static_cast<unsigned>(__builtin_popcount(bits));
+#endif
+}
+
+/**
+ * @brief Returns the number of set bits in a 64-bit mask.
+ */
+inline unsigned countBits64(uint64_t bits) {
+#if defined(_MSC_VER) && !defined(__clang__) && defined(_M_X64)
+    return static_cast<unsigned>(__popcnt64(bits));
+#elif defined(_MSC_VER) && !defined(__clang__)
+    return countBits(static_cast<unsigned>(bits)) + countBits(static_cast<unsigned>(bits >> 32));
+#else
+    return static_cast<unsigned>(__builtin_popcountll(bits));
+#endif
+}
+
+/**
+ * @brief The number of ciphertext bytes one vector decode block parses.
+ */
+constexpr size_t DECODE_BLOCK_BYTES = 64;
+
+/**
+ * @brief The ciphertext bytes a vector decode block needs: the next block's glyph starts
+ * are validated ahead of it, which reads the 2 bytes past that block as well.
+ */
+constexpr size_t DECODE_BLOCK_MARGIN = (2 * DECODE_BLOCK_BYTES) + 2;
+
+/**
+ * @brief The greedy parse of one decode block, one bit per byte.
+ *
+ * `triplets` marks the bytes where a whole triplet starts; `keep` marks the bytes that
+ * survive into the output: passthrough bytes, and triplet starts (which become letters).
+ */
+struct GlyphBlock {
+    uint64_t triplets;
+    uint64_t keep;
+};
+
+/**
+ * @brief What parseGlyphBlock() carries from one decode block into the next.
+ */
+struct GlyphCarry {
+    uint64_t starts = 0;
+    uint64_t triplets = 0;
+};
+
+/**
+ * @brief Finds the greedy parse of decodeStandard() for a decode block from its valid
+ * glyph starts alone, with no per-run branch and no data dependency between blocks
+ * beyond a few carried bits.
+ *
+ * Valid glyphs never overlap, so a run is a chain of glyph starts 3 bytes apart. A
+ * whole triplet starts where a run starts and has two more glyphs; the next one follows
+ * 9 bytes on while the run still holds three glyphs, which three doubling steps spread
+ * over the whole block. A triplet covers its 9 bytes (the multiply cannot carry, as
+ * triplet starts are at least 9 apart), and up to 8 bytes of the next block.
+ *
+ * @param starts Bit p set where a valid glyph starts at byte p of the block.
+ * @param nextStarts The same for the next block (only its first 6 bits are used).
+ * @param carry The previous block's state; updated for the next block.
+ */
+inline GlyphBlock parseGlyphBlock(uint64_t starts, uint64_t nextStarts, GlyphCarry& carry) {
+    const uint64_t runStarts = starts & ~((starts << 3) | (carry.starts >> 61));
+    uint64_t whole = starts & ((starts >> 3) | (nextStarts << 61)) & ((starts >> 6) | (nextStarts << 58));
+    uint64_t triplets = (runStarts | (carry.triplets >> 55)) & whole;
+
+    triplets |= (triplets << 9) & whole;
+    whole &= whole << 9;
+    triplets |= (triplets << 18) & whole;
+    whole &= whole << 18;
+    triplets |= (triplets << 36) & whole;
+
+    const uint64_t spill = carry.triplets >> 56;
+    const uint64_t covered = (triplets * 0x1FF) | ((spill << 1) - (spill != 0));
+    carry = {starts, triplets};
+
+    return {triplets, ~covered | triplets};
+}
+
+/**
+ * @brief Returns how many bytes of the next block the last block's final triplet covers.
+ */
+inline size_t glyphSpill(const GlyphCarry& carry) {
+    const uint64_t spill = carry.triplets >> 56;
+    return spill ? countTrailingZeros64(spill) + 1 : 0;
+}
+
+/**
+ * @brief A shuffle control over 8 lanes, for the block decoders that have no compress
+ * instruction.
+ */
+struct LaneShuffle {
+    unsigned char lanes[8];
+};
+
+constexpr std::array<LaneShuffle, 256> buildCompactShuffles() {
+    std::array<LaneShuffle, 256> table{};
+
+    for (int mask = 0; mask < 256; mask++) {
+        int kept = 0;
+        for (int lane = 0; lane < 8; lane++) {
+            table[mask].lanes[lane] = 0x80;
+        }
+        for (int lane = 0; lane < 8; lane++) {
+            if (mask & (1 << lane)) table[mask].lanes[kept++] = static_cast<unsigned char>(lane);
+        }
+    }
+
+    return table;
+}
+
+constexpr std::array<LaneShuffle, 256> buildSpreadShuffles() {
+    std::array<LaneShuffle, 256> table{};
+
+    for (int mask = 0; mask < 256; mask++) {
+        int used = 0;
+        for (int lane = 0; lane < 8; lane++) {
+            table[mask].lanes[lane] = (mask & (1 << lane)) ? static_cast<unsigned char>(used++) : 0x80;
+        }
+    }
+
+    return table;
+}
+
+/**
+ * @brief Packs the lanes whose mask bit is set to the front, in order.
+ */
+inline constexpr std::array<LaneShuffle, 256> COMPACT_SHUFFLES = buildCompactShuffles();
+
+/**
+ * @brief Spreads consecutive lanes out to the lanes whose mask bit is set, in order.
+ */
+inline constexpr std::array<LaneShuffle, 256> SPREAD_SHUFFLES = buildSpreadShuffles();
+
+/**
+ * @brief Returns a bit per group of 8 lanes, set where the group holds a set bit.
+ * Triplet starts are 9 bytes apart, so each group holds at most one of them.
+ */
+inline unsigned occupiedGroups(uint64_t bits) {
+    bits |= bits >> 4;
+    bits |= bits >> 2;
+    bits |= bits >> 1;
+    return static_cast<unsigned>(((bits & 0x0101010101010101ULL) * 0x0102040810204080ULL) >> 56);
+}
+
+// SSE4.2 kernels
+bool cpuHasSSE42();
+size_t countLettersSSE42(const unsigned char* in, size_t length);
+size_t encodeStandardSSE42(const unsigned char* in, size_t length, unsigned char* out);
+size_t encodeKeyedSSE42(const unsigned char* in, size_t length, const unsigned char* key, size_t keyLength,
+                        size_t keyIndex, unsigned char* out);
+size_t decodeStandardSSE42(const unsigned char* in, size_t length, unsigned char* out);
+size_t decodeKeyedSSE42(const unsigned char* in, size_t length, const unsigned char* key, size_t keyLength,
+                        size_t keyIndex, unsigned char* out);
+
+// AVX2 kernels
+bool cpuHasAVX2();
+size_t countLettersAVX2(const unsigned char* in, size_t length);
+size_t encodeStandardAVX2(const unsigned char* in, size_t length, unsigned char* out);
+size_t decodeStandardAVX2(const unsigned char* in, size_t length, unsigned char* out);
+size_t encodeKeyedAVX2(const unsigned char* in, size_t length, const unsigned char* key, size_t keyLength,
+                       size_t keyIndex, unsigned char* out);
+size_t decodeKeyedAVX2(const unsigned char* in, size_t length, const unsigned char* key, size_t keyLength,
+                       size_t keyIndex, unsigned char* out);
+
+// AVX-512 VBMI/VBMI2 kernels
+bool cpuHasAVX512VBMI2();
+size_t encodeStandardAVX512(const unsigned char* in, size_t length, unsigned char* out);
+size_t encodeKeyedAVX512(const unsigned char* in, size_t length, const unsigned char* key, size_t keyLength,
+                         size_t keyIndex, unsigned char* out);
+size_t decodeStandardAVX512(const unsigned char* in, size_t length, unsigned char* out);
+size_t decodeKeyedAVX512(const unsigned char* in, size_t length, const unsigned char* key, size_t keyLength,
+                         size_t keyIndex, unsigned char* out);
+
+#endif
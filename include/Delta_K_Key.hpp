@@ -0,0 +1,70 @@
+#ifndef DELTA_K_KEY_HPP
+#define DELTA_K_KEY_HPP
+
+#include <cstddef>
+#include <string_view>
+#include <vector>
+
+/**
+ * @brief How far a key's codes repeat past its last letter, so a SIMD kernel can load a
+ * full register of key codes from any key position without wrapping.
+ */
+constexpr size_t KEY_PATTERN_PADDING = 64;
+
+/**
+ * @brief The rows of a compiled key: the letter codes, then one row of negated trits
+ * (3 - trit) per glyph of a triplet, which the vector decoders add in-register.
+ */
+constexpr size_t KEY_PATTERN_ROWS = 4;
+
+/**
+ * @brief The distance between two rows of a compiled key: the key plus its repeated padding.
+ */
+inline size_t keyPatternStride(size_t keyLength) {
+    return keyLength + KEY_PATTERN_PADDING;
+}
+
+/**
+ * @brief The negated trits of one glyph position for every key letter, repeated past
+ * keyLength like the codes.
+ *
+ * @param key A compiled key's codes (see DeltaKey::codes()).
+ * @param keyLength The number of key letters.
+ * @param glyph The glyph of the triplet, 0 (most significant) to 2.
+ */
+inline const unsigned char* negatedKeyTrits(const unsigned char* key, size_t keyLength, int glyph) {
+    return key + ((static_cast<size_t>(glyph) + 1) * keyPatternStride(keyLength));
+}
+
+void fillKeyPattern(std::string_view text, unsigned char* pattern);
+
+/**
+ * @brief A keyword compiled once for every keyed encode and decode.
+ *
+ * It holds the packed letter code of every key letter (1-26, see LETTER_CODE) and its
+ * negated trits. Both are stored as a cache-aligned pattern whose rows repeat the key
+ * for KEY_PATTERN_PADDING bytes past its end, which is the layout the keyed kernels
+ * take (see codes() and fillKeyPattern()). An empty key selects Standard Mode.
+ */
+class DeltaKey {
+public:
+    DeltaKey() = default;
+    explicit DeltaKey(std::string_view text);
+
+    static bool parse(std::string_view text, DeltaKey& key);
+    void assign(std::string_view text);
+
+    bool empty() const { return keyLength == 0; }
+    size_t length() const { return keyLength; }
+    const unsigned char* codes() const;
+
+private:
+    struct alignas(64) PatternLine {
+        unsigned char bytes[64];
+    };
+
+    std::vector<PatternLine> pattern;
+    size_t keyLength = 0;
+};
+
+#endif
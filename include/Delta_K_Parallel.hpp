@@ -0,0 +1,50 @@
+#ifndef DELTA_K_PARALLEL_HPP
+#define DELTA_K_PARALLEL_HPP
+
+#include <cstddef>
+#include <string>
+#include <vector>
+
+/**
+ * @brief How a parallel encode splits its input, and where each chunk starts.
+ *
+ * Chunk c covers source bytes [inputStart[c], inputStart[c + 1]). lettersBefore is the
+ * exclusive prefix sum of the letters per chunk, so lettersBefore[c] is both the number
+ * of key positions used before chunk c and (times 8) how much the output before it grew.
+ * Both vectors hold one entry more than there are chunks; the last is the total.
+ */
+struct EncodePlan {
+    std::vector<size_t> inputStart;
+    std::vector<size_t> lettersBefore;
+};
+
+/**
+ * @brief How a parallel decode splits its input, and where each chunk starts.
+ *
+ * Chunk c decodes ciphertext bytes [inputStart[c], inputStart[c + 1]). The chunk bounds
+ * are first moved onto UTF-8 lead bytes and then onto triplet boundaries, so a triplet
+ * that straddles two chunks belongs to the one it starts in. tripletsBefore is the
+ * exclusive prefix sum of the triplets per chunk (the key positions used before chunk c),
+ * and outputStart is where chunk c writes. All vectors hold one entry more than there
+ * are chunks; the last is the total.
+ */
+struct DecodePlan {
+    std::vector<size_t> inputStart;
+    std::vector<size_t> tripletsBefore;
+    std::vector<size_t> outputStart;
+};
+
+// Multithreaded codec
+unsigned defaultThreadCount();
+EncodePlan planEncode(const unsigned char* in, size_t length, unsigned threads);
+size_t plannedEncodedSize(const EncodePlan& plan);
+size_t encodeParallel(const EncodePlan& plan, const unsigned char* in, const unsigned char* key, size_t keyLength,
+                      size_t keyIndex, unsigned char* out);
+std::string encryptParallel(const std::string& plaintext, const std::string& key, unsigned threads = 0);
+DecodePlan planDecode(const unsigned char* in, size_t length, unsigned threads);
+size_t plannedDecodedSize(const DecodePlan& plan);
+size_t decodeParallel(const DecodePlan& plan, const unsigned char* in, const unsigned char* key, size_t keyLength,
+                      size_t keyIndex, unsigned char* out);
+std::string decryptParallel(const std::string& ciphertext, const std::string& key, unsigned threads = 0);
+
+#endif
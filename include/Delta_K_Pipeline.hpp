@@ -0,0 +1,43 @@
+#ifndef DELTA_K_PIPELINE_HPP
+#define DELTA_K_PIPELINE_HPP
+
+#include <cstddef>
+#include <iosfwd>
+#include <string>
+
+/**
+ * @brief The least bytes of chunk buffers the pipeline may allocate when `memoryBudget`
+ * is left at 0, however few workers it runs.
+ */
+constexpr size_t PIPELINE_MEMORY_BUDGET = size_t{256} << 20;
+
+/**
+ * @brief The bytes of chunk buffers the default budget grows by per worker: room for two
+ * encode chunks of 4 MiB, so the default chunk count is only capped for larger chunks.
+ */
+constexpr size_t PIPELINE_WORKER_BUDGET = size_t{128} << 20;
+
+/**
+ * @brief The shape of the pipelined executor.
+ * `workers` codec threads (0 uses defaultThreadCount()) share `chunksInFlight` chunks
+ * of `chunkSize` source bytes, which bounds memory. Each chunk holds its input and its
+ * output: about 10 * chunkSize bytes when encoding and 2 * chunkSize when decoding.
+ * 0 uses two chunks per worker, plus two, but no more than fit `memoryBudget` bytes
+ * (and never fewer than two). A `memoryBudget` of 0 allows PIPELINE_WORKER_BUDGET per
+ * worker, and at least PIPELINE_MEMORY_BUDGET. Since a worker needs a chunk to code and
+ * the reader holds one, workers beyond one less than the chunk count are not started.
+ */
+struct PipelineOptions {
+    unsigned workers = 0;
+    size_t chunkSize = size_t{1} << 20;
+    size_t chunksInFlight = 0;
+    size_t memoryBudget = 0;
+};
+
+// Pipelined stream codec
+bool encryptPipelined(std::istream& in, std::ostream& out, const std::string& key,
+                      const PipelineOptions& options = PipelineOptions());
+bool decryptPipelined(std::istream& in, std::ostream& out, const std::string& key,
+                      const PipelineOptions& options = PipelineOptions());
+
+#endif
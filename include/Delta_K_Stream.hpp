@@ -0,0 +1,64 @@
+#ifndef DELTA_K_STREAM_HPP
+#define DELTA_K_STREAM_HPP
+
+#include "Delta_K_Key.hpp"
+
+#include <cstddef>
+#include <string>
+#include <string_view>
+#include <vector>
+
+/**
+ * @brief Encrypts a stream that arrives in pieces, like encrypt() over the whole stream.
+ *
+ * In Delta Mode the key position carries over from one feed() to the next. The output
+ * of each call lives in a buffer owned by the encoder, which only grows to the largest
+ * piece fed, so memory stays bounded however long the stream is. The overloads taking
+ * `out` write to the caller's buffer instead.
+ */
+class DeltaKEncoder {
+public:
+    explicit DeltaKEncoder(const std::string& key = "");
+    explicit DeltaKEncoder(const DeltaKey& key);
+
+    std::string_view feed(std::string_view plaintext);
+    size_t feed(std::string_view plaintext, char* out);
+    std::string_view finish();
+    size_t finish(char* out);
+
+private:
+    DeltaKey key;
+    size_t keyIndex = 0;
+    std::vector<unsigned char> output;
+};
+
+/**
+ * @brief Decrypts a stream that arrives in pieces, like decrypt() over the whole stream.
+ *
+ * A glyph or triplet cut by the end of a piece is held back (at most 8 bytes) until
+ * the next feed() completes it or finish() copies it through. In Delta Mode the key
+ * position carries over from one call to the next. As with DeltaKEncoder, the output
+ * buffer only grows to the largest piece fed.
+ */
+class DeltaKDecoder {
+public:
+    explicit DeltaKDecoder(const std::string& key = "");
+    explicit DeltaKDecoder(const DeltaKey& key);
+
+    std::string_view feed(std::string_view ciphertext);
+    size_t feed(std::string_view ciphertext, char* out);
+    std::string_view finish();
+    size_t finish(char* out);
+
+private:
+    size_t decodeInto(const unsigned char* in, size_t length, unsigned char* out);
+
+    DeltaKey key;
+    size_t keyIndex = 0;
+    std::vector<unsigned char> output;
+    // The held-back tail, plus the bytes of the next piece borrowed to finish it.
+    unsigned char pending[32];
+    size_t pendingLength = 0;
+};
+
+#endif
@@ -0,0 +1,317 @@
+#ifndef DELTA_K_TABLES_HPP
+#define DELTA_K_TABLES_HPP
+
+#include "Delta_K.hpp"
+
+#include <array>
+#include <cstdint>
+#include <cstring>
+
+/**
+ * @brief The raw UTF-8 bytes of each glyph, indexed by trit value.
+ * ▲ = E2 96 B2, ▼ = E2 96 BC, ◆ = E2 97 86.
+ */
+constexpr unsigned char GLYPH_BYTES[BASE][GLYPH_SIZE] = {
+    {0xE2, 0x96, 0xB2}, {0xE2, 0x96, 0xBC}, {0xE2, 0x97, 0x86}
+};
+
+/**
+ * @brief The number of bytes a full glyph triplet (one encoded letter) occupies.
+ */
+constexpr int TRIPLET_SIZE = GLYPH_SIZE * BASE;
+
+/**
+ * @brief The width every GlyphEntry is padded to, and therefore the width of each table store.
+ */
+constexpr int ENTRY_WIDTH = 16;
+
+/**
+ * @brief A precomputed encoder output: the finished bytes a single source byte turns into.
+ *
+ * Entries are padded to ENTRY_WIDTH bytes so the encoder can always copy a fixed width
+ * and then advance the output by `length`.
+ */
+struct alignas(ENTRY_WIDTH) GlyphEntry {
+    unsigned char bytes[ENTRY_WIDTH - 1];
+    unsigned char length;
+};
+
+/**
+ * @brief Builds the entry holding the 9 glyph bytes for a trit triplet.
+ */
+constexpr GlyphEntry makeTripletEntry(int trit1, int trit2, int trit3) {
+    GlyphEntry entry{};
+    const int trits[BASE] = {trit1, trit2, trit3};
+
+    for (int j = 0; j < BASE; j++) {
+        for (int b = 0; b < GLYPH_SIZE; b++) {
+            entry.bytes[(j * GLYPH_SIZE) + b] = GLYPH_BYTES[trits[j]][b];
+        }
+    }
+    entry.length = TRIPLET_SIZE;
+
+    return entry;
+}
+
+/**
+ * @brief Builds the 256-entry Standard Mode table.
+ *
+ * Letters (either case) map to their glyph triplet from TRIT_ALPHABET, every other
+ * byte maps to itself.
+ */
+constexpr std::array<GlyphEntry, 256> buildStandardTable() {
+    std::array<GlyphEntry, 256> table{};
+
+    for (int c = 0; c < 256; c++) {
+        int abcValue = -1;
+        if (c >= 'A' && c <= 'Z') abcValue = c - 'A';
+        if (c >= 'a' && c <= 'z') abcValue = c - 'a';
+
+        if (abcValue >= 0) {
+            const int* trits = TRIT_ALPHABET[abcValue];
+            table[c] = makeTripletEntry(trits[0], trits[1], trits[2]);
+        } else {
+            table[c].bytes[0] = static_cast<unsigned char>(c);
+            table[c].length = 1;
+        }
+    }
+
+    return table;
+}
+
+/**
+ * @brief Standard Mode encoder table, indexed by source byte.
+ */
+inline constexpr std::array<GlyphEntry, 256> STANDARD_TABLE = buildStandardTable();
+
+/**
+ * @brief Returns the trit code (0-26) of a trit triplet, i.e. its Base-3 value.
+ * Letters occupy codes 1-26 (A = 001, Z = 222); code 0 (▲▲▲) is not a letter.
+ */
+constexpr int tritCode(int trit1, int trit2, int trit3) {
+    return (trit1 * BASE * BASE) + (trit2 * BASE) + trit3;
+}
+
+/**
+ * @brief Adds two trit codes digit by digit, modulo 3 (the Delta Mode operation).
+ */
+constexpr int tritAdd(int code1, int code2) {
+    int result = 0;
+    for (int place = BASE * BASE; place > 0; place /= BASE) {
+        result += (((code1 / place) + (code2 / place)) % BASE) * place;
+        code1 %= place;
+        code2 %= place;
+    }
+    return result;
+}
+
+/**
+ * @brief Subtracts two trit codes digit by digit, modulo 3 (undoes tritAdd()).
+ */
+constexpr int tritSub(int code1, int code2) {
+    int result = 0;
+    for (int place = BASE * BASE; place > 0; place /= BASE) {
+        result += (((code1 / place) - (code2 / place) + BASE) % BASE) * place;
+        code1 %= place;
+        code2 %= place;
+    }
+    return result;
+}
+
+/**
+ * @brief Builds the letter code table: A-Z and a-z map to 1-26, every other byte to 0.
+ */
+constexpr std::array<unsigned char, 256> buildLetterCodes() {
+    std::array<unsigned char, 256> table{};
+
+    for (int c = 'A'; c <= 'Z'; c++) {
+        table[c] = static_cast<unsigned char>(c - 'A' + 1);
+        table[c + ('a' - 'A')] = static_cast<unsigned char>(c - 'A' + 1);
+    }
+
+    return table;
+}
+
+/**
+ * @brief The trit code of each byte if it is a letter, or 0 if it is not.
+ */
+inline constexpr std::array<unsigned char, 256> LETTER_CODE = buildLetterCodes();
+
+/**
+ * @brief The number of distinct trit codes (0-26), and so the number of key rows.
+ */
+constexpr int TRIT_CODES = BASE * BASE * BASE;
+
+/**
+ * @brief Builds the Delta Mode table: the finished glyph triplet for every
+ * (key code, plaintext letter) pair.
+ *
+ * Rows are indexed by the key letter's trit code, so row 0 is a key that shifts
+ * nothing; columns by the plaintext letter's trit code.
+ */
+constexpr std::array<std::array<GlyphEntry, TRIT_CODES>, TRIT_CODES> buildKeyedTable() {
+    std::array<std::array<GlyphEntry, TRIT_CODES>, TRIT_CODES> table{};
+
+    for (int key = 0; key < TRIT_CODES; key++) {
+        for (int letter = 0; letter < TRIT_CODES; letter++) {
+            int keyed = tritAdd(letter, key);
+            table[key][letter] = makeTripletEntry(keyed / (BASE * BASE), (keyed / BASE) % BASE, keyed % BASE);
+        }
+    }
+
+    return table;
+}
+
+/**
+ * @brief Delta Mode encoder table, indexed by [key code][plaintext letter code].
+ */
+inline constexpr std::array<std::array<GlyphEntry, TRIT_CODES>, TRIT_CODES> KEYED_TABLE = buildKeyedTable();
+
+/**
+ * @brief Builds the Delta Mode byte table: for every key code, the finished output of
+ * every source byte. Letters map to their KEYED_TABLE triplet, every other byte to its
+ * STANDARD_TABLE entry (itself), so mixed text needs no choice between the two tables.
+ */
+constexpr std::array<std::array<GlyphEntry, 256>, TRIT_CODES> buildKeyedByteTable() {
+    std::array<std::array<GlyphEntry, 256>, TRIT_CODES> table{};
+
+    for (int key = 0; key < TRIT_CODES; key++) {
+        for (int c = 0; c < 256; c++) {
+            table[key][c] = LETTER_CODE[c] ? KEYED_TABLE[key][LETTER_CODE[c]] : STANDARD_TABLE[c];
+        }
+    }
+
+    return table;
+}
+
+/**
+ * @brief Delta Mode encoder table, indexed by [key code][source byte].
+ */
+inline constexpr std::array<std::array<GlyphEntry, 256>, TRIT_CODES> KEYED_BYTE_TABLE = buildKeyedByteTable();
+
+/**
+ * @brief Builds the decoder's output table: the character each trit code decodes to.
+ * Codes 1-26 are 'A'-'Z'; code 0 (▲▲▲) decodes to '@', the character before 'A'.
+ */
+constexpr std::array<char, TRIT_CODES> buildTripletLetters() {
+    std::array<char, TRIT_CODES> table{};
+
+    for (int code = 0; code < TRIT_CODES; code++) {
+        table[code] = static_cast<char>('A' + code - 1);
+    }
+
+    return table;
+}
+
+/**
+ * @brief Standard Mode decoder table, indexed by the trit code of a glyph triplet.
+ */
+inline constexpr std::array<char, TRIT_CODES> TRIPLET_LETTER = buildTripletLetters();
+
+/**
+ * @brief Builds the Delta Mode decoder table: the plaintext character for every
+ * (key code, ciphertext triplet code) pair.
+ */
+constexpr std::array<std::array<char, TRIT_CODES>, TRIT_CODES> buildInverseTable() {
+    std::array<std::array<char, TRIT_CODES>, TRIT_CODES> table{};
+
+    for (int key = 0; key < TRIT_CODES; key++) {
+        for (int code = 0; code < TRIT_CODES; code++) {
+            table[key][code] = TRIPLET_LETTER[tritSub(code, key)];
+        }
+    }
+
+    return table;
+}
+
+/**
+ * @brief Delta Mode decoder table, indexed by [key code][ciphertext triplet code].
+ */
+inline constexpr std::array<std::array<char, TRIT_CODES>, TRIT_CODES> INVERSE_TABLE = buildInverseTable();
+
+/**
+ * @brief Builds the glyph triplet of every trit code (0-26).
+ */
+constexpr std::array<GlyphEntry, TRIT_CODES> buildTripletTable() {
+    std::array<GlyphEntry, TRIT_CODES> table{};
+
+    for (int code = 0; code < TRIT_CODES; code++) {
+        table[code] = makeTripletEntry(code / (BASE * BASE), (code / BASE) % BASE, code % BASE);
+    }
+
+    return table;
+}
+
+/**
+ * @brief The glyph triplet of each trit code, used to verify a triplet in one compare.
+ */
+inline constexpr std::array<GlyphEntry, TRIT_CODES> TRIPLET_TABLE = buildTripletTable();
+
+/**
+ * @brief Trit value keyed by the low nibble of a glyph's final byte (B2 -> 0, BC -> 1, 86 -> 2).
+ * The three final bytes have distinct low nibbles, so one lookup identifies a glyph.
+ * Every other nibble maps to 0; callers must verify the bytes against TRIPLET_TABLE.
+ */
+inline constexpr unsigned char FINAL_NIBBLE_TRIT[16] = {
+    0, 0, 0, 0, 0, 0, 2, 0, 0, 0, 0, 0, 1, 0, 0, 0
+};
+
+/**
+ * @brief Reads a full glyph triplet starting at `p` with one hash and one verification.
+ *
+ * The trit code is computed from the final byte of each glyph alone (see
+ * FINAL_NIBBLE_TRIT), then all nine bytes are compared against that code's triplet.
+ *
+ * @param p Points at (at least) TRIPLET_SIZE readable bytes.
+ * @return int The trit code (0-26) of the triplet, or -1 if the bytes are not a valid triplet.
+ */
+inline int matchTriplet(const unsigned char* p) {
+    int code = (FINAL_NIBBLE_TRIT[p[2] & 0xF] * BASE * BASE) + (FINAL_NIBBLE_TRIT[p[5] & 0xF] * BASE) +
+               FINAL_NIBBLE_TRIT[p[8] & 0xF];
+    const GlyphEntry& expected = TRIPLET_TABLE[code];
+
+    uint64_t word;
+    uint64_t expectedWord;
+    std::memcpy(&word, p, sizeof(word));
+    std::memcpy(&expectedWord, expected.bytes, sizeof(expectedWord));
+
+    return (word == expectedWord && p[8] == expected.bytes[8]) ? code : -1;
+}
+
+/**
+ * @brief Reads the glyph starting at `p` straight from its UTF-8 bytes.
+ * All three glyphs share the lead byte E2, so the second and third bytes decide.
+ *
+ * @param p Points at (at least) GLYPH_SIZE readable bytes.
+ * @return int The trit value (0-2) of the glyph, or -1 if the bytes are not a glyph.
+ */
+inline int glyphTrit(const unsigned char* p) {
+    if (p[0] != 0xE2) return -1;
+
+    if (p[1] == 0x96) {
+        if (p[2] == 0xB2) return 0;
+        if (p[2] == 0xBC) return 1;
+    } else if (p[1] == 0x97 && p[2] == 0x86) {
+        return 2;
+    }
+
+    return -1;
+}
+
+/**
+ * @brief Reads a full glyph triplet starting at `p`.
+ *
+ * @param p Points at (at least) TRIPLET_SIZE readable bytes.
+ * @return int The trit code (0-26) of the triplet, or -1 if any of its three glyphs is invalid.
+ */
+inline int tripletCode(const unsigned char* p) {
+    int trit1 = glyphTrit(p);
+    int trit2 = glyphTrit(p + GLYPH_SIZE);
+    int trit3 = glyphTrit(p + (GLYPH_SIZE * 2));
+
+    if ((trit1 | trit2 | trit3) < 0) return -1;
+
+    return tritCode(trit1, trit2, trit3);
+}
+
+#endif
@@ -1,34 +1,33 @@
 #include "Delta_K.hpp"
+#include "Delta_K_Dispatch.hpp"
+#include "Delta_K_Engine.hpp"
+#include "Delta_K_Tables.hpp"
 
+#include <algorithm>
 #include <iostream>
 #include <string>
 #include <cctype>
+#include <vector>
 
 /**
  * @brief Performs standard monoalphabetic encryption (Unkeyed).
  * * Converts each alphabetic character in the plaintext directly to its
  * corresponding sequence of 3 glyphs from the TRIT_ALPHABET.
+ * * The ciphertext is sized exactly up front (every letter grows to 9 bytes) and filled
+ * by the table-driven encoder (see encodeStandard()), so no reallocation happens while
+ * encoding. Counting and encoding run on the fastest kernels this CPU supports (see
+ * activeKernels()).
  * * @param plaintext The source string to encrypt.
  * @return std::string The resulting string of glyphs.
  * @note Non-alphabetic characters are preserved as-is. Spaces (' ') are converted to forward slashes.
  */
 std::string encrypt(const std::string& plaintext) {
-    std::string ciphertext = "";
-
-    for (size_t i = 0; i < plaintext.length(); i++) {
-        char currentChar = plaintext[i];
-
-        if (std::isalpha(currentChar)) {
-            int abcValue = abcPosition(currentChar);
-            for (int j = 0; j < BASE; j++) {
-                ciphertext += GLYPHS[TRIT_ALPHABET[abcValue][j]]; // add the 3 corresponding glyphs to the ciphertext
-            }
-        } else if (currentChar == ' ') {
-            ciphertext += ' ';
-        } else {
-            ciphertext += currentChar;
-        }
-    }
+    const unsigned char* in = reinterpret_cast<const unsigned char*>(plaintext.data());
+    const KernelSet& kernels = activeKernels();
+    std::string ciphertext;
+
+    ciphertext.resize(plaintext.length() + (kernels.countLetters(in, plaintext.length()) * (TRIPLET_SIZE - 1)));
+    kernels.encodeStandard(in, plaintext.length(), reinterpret_cast<unsigned char*>(&ciphertext[0]));
 
     return ciphertext;
 }
@@ -40,38 +39,39 @@ std::string encrypt(const std::string& plaintext) {
  * 2. It looks up the trits for both the plaintext letter and the key letter.
  * 3. It adds the trits together modulo 3 ((plain + key) % 3).
  * 4. The resulting values determine the final glyphs.
+ * * The key is compiled once (see DeltaKey), and every (plaintext letter, key letter)
+ * pair is a single lookup into the precompiled KEYED_TABLE (see encodeKeyed()). The SIMD
+ * kernels (see activeKernels()) align the key in-register instead.
  * * @param plaintext The source string to encrypt.
  * @param key The keyword used to scramble the encryption.
  * @return std::string The resulting string of glyphs.
  * @note This method effectively creates a unique symbol set for every letter, making
  * frequency analysis significantly more difficult.
+ * @note An empty key falls back to Standard Mode.
  */
 std::string encrypt(const std::string& plaintext, const std::string& key) {
-    std::string ciphertext = "";
-    size_t keyIndex = 0;
+    if (key.empty()) return encrypt(plaintext);
 
-    for (size_t i = 0; i < plaintext.length(); i++) {
-        char currentChar = plaintext[i];
+    return encrypt(plaintext, DeltaKey(key));
+}
 
-        if (std::isalpha(currentChar)) {
-            char currentKeyChar = key[keyIndex % key.length()];
-            int keyAbcVal = abcPosition(currentKeyChar);
+/**
+ * @brief Delta Mode encrypt() with a key compiled once (see DeltaKey), for callers that
+ * reuse one key across many messages.
+ * * @param plaintext The source string to encrypt.
+ * @param key The compiled keyword; an empty key falls back to Standard Mode.
+ * @return std::string The resulting string of glyphs.
+ */
+std::string encrypt(const std::string& plaintext, const DeltaKey& key) {
+    if (key.empty()) return encrypt(plaintext);
 
-            int abcVal = abcPosition(currentChar);
+    const unsigned char* in = reinterpret_cast<const unsigned char*>(plaintext.data());
+    const KernelSet& kernels = activeKernels();
+    std::string ciphertext;
 
-            for (int j = 0; j < BASE; j++) {
-                int keyedValue = TRIT_ALPHABET[abcVal][j] + TRIT_ALPHABET[keyAbcVal][j];
-                keyedValue %= 3;
-                ciphertext += GLYPHS[keyedValue]; 
-            }
-            
-            keyIndex++; 
-        } else if (currentChar == ' ') {
-            ciphertext += ' ';
-        } else {
-            ciphertext += currentChar;
-        }
-    }
+    ciphertext.resize(plaintext.length() + (kernels.countLetters(in, plaintext.length()) * (TRIPLET_SIZE - 1)));
+    kernels.encodeKeyed(in, plaintext.length(), key.codes(), key.length(), 0,
+                        reinterpret_cast<unsigned char*>(&ciphertext[0]));
 
     return ciphertext;
 }
@@ -82,35 +82,270 @@ std::string encrypt(const std::string& plaintext, const std::string& key) {
  * and sequences of glyphs. Valid glyph sequences are parsed in groups of three, 
  * converted to their numeric trit values, and mapped back to their corresponding 
  * alphabetic characters.
+ * * Glyphs are matched straight from their raw UTF-8 bytes (see decodeStandard()), so
+ * decoding allocates only the output string. Glyph runs that are cut short (such as a
+ * truncated final triplet) are preserved as-is instead of being read past the end.
+ * The decoder itself is the fastest kernel this CPU supports (see activeKernels()).
  * * @param ciphertext The string of glyphs (and punctuation) to decode.
  * @return std::string The recovered plaintext.
  */
 std::string decrypt(const std::string& ciphertext) {
-    std::string plaintext = "";
+    std::string plaintext;
 
-    for (size_t i = 0; i < ciphertext.length(); i++) {
-        std::string current1 = ciphertext.substr(i, GLYPH_SIZE);
+    plaintext.resize(ciphertext.length());
+    size_t written = activeKernels().decodeStandard(reinterpret_cast<const unsigned char*>(ciphertext.data()),
+                                                    ciphertext.length(),
+                                                    reinterpret_cast<unsigned char*>(&plaintext[0]));
+    plaintext.resize(written);
 
-        if (!isGlyph(current1)) {
-            plaintext += ciphertext[i];
-        } else {
-            char decryptedChar;
+    return plaintext;
+}
+
+/**
+ * @brief Decodes a Delta Mode (Keyed) string of trinary glyphs back into plaintext.
+ * * Parses the ciphertext exactly like the unkeyed decrypt(). For each glyph triplet:
+ * 1. It identifies the corresponding letter in the key (cycling through the key if necessary).
+ * 2. It subtracts the key's trits from the triplet's trits modulo 3 ((cipher - key) % 3).
+ * 3. The resulting values determine the plaintext letter.
+ * * Every (triplet, key letter) pair is a single lookup into the precompiled
+ * INVERSE_TABLE (see decodeKeyed()), and the key only advances on decoded letters.
+ * The decoder itself is the fastest kernel this CPU supports (see activeKernels()).
+ * * @param ciphertext The string of glyphs (and punctuation) to decode.
+ * @param key The keyword the ciphertext was encrypted with.
+ * @return std::string The recovered plaintext.
+ * @note An empty key falls back to Standard Mode.
+ */
+std::string decrypt(const std::string& ciphertext, const std::string& key) {
+    if (key.empty()) return decrypt(ciphertext);
+
+    return decrypt(ciphertext, DeltaKey(key));
+}
+
+/**
+ * @brief Delta Mode decrypt() with a key compiled once (see DeltaKey).
+ * * @param ciphertext The string of glyphs (and punctuation) to decode.
+ * @param key The compiled keyword; an empty key falls back to Standard Mode.
+ * @return std::string The recovered plaintext.
+ */
+std::string decrypt(const std::string& ciphertext, const DeltaKey& key) {
+    if (key.empty()) return decrypt(ciphertext);
 
-            std::string current2 = ciphertext.substr(i + GLYPH_SIZE, GLYPH_SIZE);
-            std::string current3 = ciphertext.substr(i + (GLYPH_SIZE * 2), GLYPH_SIZE);
+    std::string plaintext;
 
-            int glyphSeq1 = glyphVal(current1);
-            int glyphSeq2 = glyphVal(current2); 
-            int glyphSeq3 = glyphVal(current3);
+    plaintext.resize(ciphertext.length());
+    size_t written = activeKernels().decodeKeyed(reinterpret_cast<const unsigned char*>(ciphertext.data()),
+                                                 ciphertext.length(), key.codes(), key.length(), 0,
+                                                 reinterpret_cast<unsigned char*>(&plaintext[0]));
+    plaintext.resize(written);
 
-            decryptedChar = static_cast<char>('A' + (glyphSeq1 * BASE * BASE) + (glyphSeq2 * BASE) + glyphSeq3 - 1);
-            plaintext += decryptedChar;
+    return plaintext;
+}
 
-            i += (GLYPH_SIZE * 3) - 1;
+/**
+ * @brief The most key letters a call converts on the stack; longer keys use the heap.
+ */
+constexpr size_t STACK_KEY_LENGTH = 64;
+
+/**
+ * @brief The source bytes coded per piece by the sink functions; the output piece lives
+ * on the stack.
+ */
+constexpr size_t SINK_BLOCK = 2048;
+
+/**
+ * @brief A key's trit codes for the length of one call, laid out like DeltaKey::codes().
+ * Keys of up to STACK_KEY_LENGTH letters are converted on the stack, so the usual call
+ * allocates nothing.
+ */
+struct CallKey {
+    explicit CallKey(std::string_view key) : length(key.length()) {
+        if (length > STACK_KEY_LENGTH) heap.resize(KEY_PATTERN_ROWS * keyPatternStride(length));
+        codes = heap.empty() ? local : heap.data();
+
+        if (length) fillKeyPattern(key, codes);
+    }
+
+    alignas(64) unsigned char local[KEY_PATTERN_ROWS * (STACK_KEY_LENGTH + KEY_PATTERN_PADDING)];
+    std::vector<unsigned char> heap;
+    unsigned char* codes;
+    size_t length;
+};
+
+/**
+ * @brief Computes the exact ciphertext length of a text, in either mode.
+ * * Every letter grows from 1 byte to a 9-byte triplet, so this is one counting pass
+ * over the text (see countLetters()); the key never changes the length.
+ * * @param plaintext The source text.
+ * @return size_t The number of bytes encryptInto() will write.
+ */
+size_t encodedSize(std::string_view plaintext) {
+    const unsigned char* in = reinterpret_cast<const unsigned char*>(plaintext.data());
+    return plaintext.length() + (activeKernels().countLetters(in, plaintext.length()) * (TRIPLET_SIZE - 1));
+}
+
+/**
+ * @brief Computes the exact plaintext length of a ciphertext, in either mode.
+ * * Every decoded triplet shrinks from 9 bytes to 1 (see countTriplets()).
+ * * @param ciphertext The glyph text.
+ * @return size_t The number of bytes decryptInto() will write.
+ */
+size_t decodedSize(std::string_view ciphertext) {
+    const unsigned char* in = reinterpret_cast<const unsigned char*>(ciphertext.data());
+    return ciphertext.length() - (countTriplets(in, ciphertext.length()) * (TRIPLET_SIZE - 1));
+}
+
+/**
+ * @brief Standard Mode encrypt() into the caller's buffer; nothing is allocated.
+ * * @param plaintext The source text.
+ * @param out The destination; must hold encodedSize(plaintext) bytes.
+ * @return size_t The number of bytes written.
+ */
+size_t encryptInto(std::string_view plaintext, char* out) {
+    return activeKernels().encodeStandard(reinterpret_cast<const unsigned char*>(plaintext.data()),
+                                          plaintext.length(), reinterpret_cast<unsigned char*>(out));
+}
+
+/**
+ * @brief Delta Mode encrypt() into the caller's buffer; nothing is allocated for keys of
+ * up to 64 letters.
+ * * @param plaintext The source text.
+ * @param key The keyword; empty falls back to Standard Mode.
+ * @param out The destination; must hold encodedSize(plaintext) bytes.
+ * @return size_t The number of bytes written.
+ */
+size_t encryptInto(std::string_view plaintext, std::string_view key, char* out) {
+    if (key.empty()) return encryptInto(plaintext, out);
+
+    CallKey codes(key);
+    return activeKernels().encodeKeyed(reinterpret_cast<const unsigned char*>(plaintext.data()),
+                                       plaintext.length(), codes.codes, codes.length, 0,
+                                       reinterpret_cast<unsigned char*>(out));
+}
+
+/**
+ * @brief Delta Mode encrypt() into the caller's buffer with a compiled key.
+ * * @param plaintext The source text.
+ * @param key The compiled keyword; empty falls back to Standard Mode.
+ * @param out The destination; must hold encodedSize(plaintext) bytes.
+ * @return size_t The number of bytes written.
+ */
+size_t encryptInto(std::string_view plaintext, const DeltaKey& key, char* out) {
+    if (key.empty()) return encryptInto(plaintext, out);
+
+    return activeKernels().encodeKeyed(reinterpret_cast<const unsigned char*>(plaintext.data()),
+                                       plaintext.length(), key.codes(), key.length(), 0,
+                                       reinterpret_cast<unsigned char*>(out));
+}
+
+/**
+ * @brief Standard Mode decrypt() into the caller's buffer; nothing is allocated.
+ * * @param ciphertext The glyph text.
+ * @param out The destination; must hold decodedSize(ciphertext) bytes (or simply as
+ * many bytes as the ciphertext, which is never less).
+ * @return size_t The number of bytes written.
+ */
+size_t decryptInto(std::string_view ciphertext, char* out) {
+    return activeKernels().decodeStandard(reinterpret_cast<const unsigned char*>(ciphertext.data()),
+                                          ciphertext.length(), reinterpret_cast<unsigned char*>(out));
+}
+
+/**
+ * @brief Delta Mode decrypt() into the caller's buffer; nothing is allocated for keys of
+ * up to 64 letters.
+ * * @param ciphertext The glyph text.
+ * @param key The keyword it was encrypted with; empty falls back to Standard Mode.
+ * @param out The destination; must hold decodedSize(ciphertext) bytes (or simply as
+ * many bytes as the ciphertext, which is never less).
+ * @return size_t The number of bytes written.
+ */
+size_t decryptInto(std::string_view ciphertext, std::string_view key, char* out) {
+    if (key.empty()) return decryptInto(ciphertext, out);
+
+    CallKey codes(key);
+    return activeKernels().decodeKeyed(reinterpret_cast<const unsigned char*>(ciphertext.data()),
+                                       ciphertext.length(), codes.codes, codes.length, 0,
+                                       reinterpret_cast<unsigned char*>(out));
+}
+
+/**
+ * @brief Delta Mode decrypt() into the caller's buffer with a compiled key.
+ * * @param ciphertext The glyph text.
+ * @param key The compiled keyword; empty falls back to Standard Mode.
+ * @param out The destination; must hold decodedSize(ciphertext) bytes.
+ * @return size_t The number of bytes written.
+ */
+size_t decryptInto(std::string_view ciphertext, const DeltaKey& key, char* out) {
+    if (key.empty()) return decryptInto(ciphertext, out);
+
+    return activeKernels().decodeKeyed(reinterpret_cast<const unsigned char*>(ciphertext.data()),
+                                       ciphertext.length(), key.codes(), key.length(), 0,
+                                       reinterpret_cast<unsigned char*>(out));
+}
+
+/**
+ * @brief Encrypts into a sink piece by piece (see encryptTo()).
+ * * Each piece of SINK_BLOCK source bytes is encoded into a stack buffer and handed to
+ * `write`; the key position carries over, advanced by the output growth of each piece
+ * (8 bytes per letter).
+ * * @param plaintext The source text.
+ * @param key The keyword, or empty for Standard Mode.
+ * @param write Called with every piece of ciphertext, in order.
+ * @param sink Passed back to `write`.
+ */
+void encryptToSink(std::string_view plaintext, std::string_view key, SinkWriter write, void* sink) {
+    const KernelSet& kernels = activeKernels();
+    const unsigned char* in = reinterpret_cast<const unsigned char*>(plaintext.data());
+    CallKey codes(key);
+    unsigned char buffer[SINK_BLOCK * TRIPLET_SIZE];
+    size_t keyIndex = 0;
+
+    for (size_t i = 0; i < plaintext.length(); i += SINK_BLOCK) {
+        const size_t length = std::min(SINK_BLOCK, plaintext.length() - i);
+        size_t written;
+
+        if (codes.length) {
+            written = kernels.encodeKeyed(in + i, length, codes.codes, codes.length, keyIndex, buffer);
+            keyIndex = (keyIndex + ((written - length) / (TRIPLET_SIZE - 1))) % codes.length;
+        } else {
+            written = kernels.encodeStandard(in + i, length, buffer);
         }
+
+        write(sink, reinterpret_cast<const char*>(buffer), written);
     }
+}
 
-    return plaintext;
+/**
+ * @brief Decrypts into a sink piece by piece (see decryptTo()).
+ * * Each piece ends on its last triplet boundary (see decodableLength()), so a triplet is
+ * never cut; the next piece starts right there. The key position carries over, advanced
+ * by the output shrinkage of each piece (8 bytes per triplet).
+ * * @param ciphertext The glyph text.
+ * @param key The keyword it was encrypted with, or empty for Standard Mode.
+ * @param write Called with every piece of plaintext, in order.
+ * @param sink Passed back to `write`.
+ */
+void decryptToSink(std::string_view ciphertext, std::string_view key, SinkWriter write, void* sink) {
+    const KernelSet& kernels = activeKernels();
+    const unsigned char* in = reinterpret_cast<const unsigned char*>(ciphertext.data());
+    CallKey codes(key);
+    unsigned char buffer[SINK_BLOCK];
+    size_t keyIndex = 0;
+
+    for (size_t i = 0; i < ciphertext.length();) {
+        size_t length = std::min(SINK_BLOCK, ciphertext.length() - i);
+        if (i + length < ciphertext.length()) length = decodableLength(in + i, length);
+
+        size_t written;
+        if (codes.length) {
+            written = kernels.decodeKeyed(in + i, length, codes.codes, codes.length, keyIndex, buffer);
+            keyIndex = (keyIndex + ((length - written) / (TRIPLET_SIZE - 1))) % codes.length;
+        } else {
+            written = kernels.decodeStandard(in + i, length, buffer);
+        }
+
+        write(sink, reinterpret_cast<const char*>(buffer), written);
+        i += length;
+    }
 }
 
 /**
@@ -149,11 +384,8 @@ bool keyValidation(const std::string& key) {
  * @return true If the string matches '▲', '▼', or '◆'.
  * @return false If the string is not a recognized glyph.
  */
-bool isGlyph(std::string c) {
-    if (c == GLYPHS[0] || c == GLYPHS[1] || c == GLYPHS[2]) {
-        return true;
-    }
-    return false;
+bool isGlyph(const std::string& c) {
+    return glyphVal(c) != -1;
 }
 
 /**
@@ -165,15 +397,9 @@ bool isGlyph(std::string c) {
  * * @param c The glyph string to convert.
  * @return int The numeric value (0-2) of the glyph, or -1 if the input is invalid.
  */
-int glyphVal(std::string c) {
-    if (c == GLYPHS[0]) {
-        return 0;
-    } else if (c == GLYPHS[1]) {
-        return 1;
-    } else if (c == GLYPHS [2]) {
-        return 2;
-    }
+int glyphVal(const std::string& c) {
+    if (c.length() != GLYPH_SIZE) return -1;
 
-    return -1;
+    return glyphTrit(reinterpret_cast<const unsigned char*>(c.data()));
 }
 
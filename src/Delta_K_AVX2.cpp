@@ -0,0 +1,767 @@
+#include "Delta_K_Engine.hpp"
+#include "Delta_K_Kernels.hpp"
+#include "Delta_K_Tables.hpp"
+
+#include <array>
+#include <cstdint>
+#include <cstring>
+
+#ifdef DELTA_K_X86
+#include <immintrin.h>
+#endif
+
+/**
+ * @brief Checks whether the CPU (and OS) support AVX2.
+ *
+ * @return true If the AVX2 kernels can run on this host.
+ */
+bool cpuHasAVX2() {
+#if defined(DELTA_K_X86) && (defined(__GNUC__) || defined(__clang__))
+    return __builtin_cpu_supports("avx2");
+#elif defined(DELTA_K_X86) && defined(_MSC_VER)
+    int info[4];
+    __cpuid(info, 1);
+    bool osSavesYmm = (info[2] & (1 << 27)) && ((_xgetbv(0) & 0x6) == 0x6);
+    __cpuidex(info, 7, 0);
+    return osSavesYmm && (info[1] & (1 << 5));
+#else
+    return false;
+#endif
+}
+
+#ifdef DELTA_K_X86
+
+/**
+ * @brief The number of letters one expansion step turns into glyphs.
+ */
+constexpr int EXPAND_LETTERS = 16;
+
+/**
+ * @brief The bytes one expansion step writes: 16 triplets (144 bytes), rounded up to 32-byte stores.
+ */
+constexpr int EXPAND_BYTES = 160;
+
+/**
+ * @brief Shuffle controls for the 1 -> 9 byte expansion.
+ *
+ * For output byte p of an expansion step, the letter is p / 9, the glyph within the
+ * triplet is (p % 9) / 3 and the byte within the glyph is p % 3.
+ * - gather[g][p] selects the letter's trit g (or 0x80, which shuffles in a zero, when
+ *   byte p belongs to another glyph).
+ * - offset[p] is 3 * (byte within the glyph), so trit + offset[p] indexes GLYPH_BYTE_LUT.
+ */
+struct ExpandTables {
+    alignas(32) unsigned char gather[BASE][EXPAND_BYTES];
+    alignas(32) unsigned char offset[EXPAND_BYTES];
+};
+
+constexpr ExpandTables buildExpandTables() {
+    ExpandTables tables{};
+
+    for (int p = 0; p < EXPAND_BYTES; p++) {
+        int letter = p / TRIPLET_SIZE;
+        int glyph = (p % TRIPLET_SIZE) / GLYPH_SIZE;
+
+        for (int g = 0; g < BASE; g++) {
+            bool selected = (g == glyph) && (letter < EXPAND_LETTERS);
+            tables.gather[g][p] = selected ? static_cast<unsigned char>(letter) : 0x80;
+        }
+        tables.offset[p] = static_cast<unsigned char>(BASE * (p % GLYPH_SIZE));
+    }
+
+    return tables;
+}
+
+static constexpr ExpandTables EXPAND = buildExpandTables();
+
+/**
+ * @brief Glyph bytes indexed by trit + 3 * (byte within the glyph), repeated in both 128-bit lanes.
+ */
+alignas(32) static constexpr unsigned char GLYPH_BYTE_LUT[32] = {
+    0xE2, 0xE2, 0xE2, 0x96, 0x96, 0x97, 0xB2, 0xBC, 0x86, 0, 0, 0, 0, 0, 0, 0,
+    0xE2, 0xE2, 0xE2, 0x96, 0x96, 0x97, 0xB2, 0xBC, 0x86, 0, 0, 0, 0, 0, 0, 0
+};
+
+/**
+ * @brief The three trits of every trit code (0-26) packed as t1 | t2 << 2 | t3 << 4,
+ * split into the two 16-entry halves a byte shuffle can index.
+ */
+constexpr std::array<unsigned char, 32> buildPackedTrits() {
+    std::array<unsigned char, 32> table{};
+
+    for (int code = 0; code < TRIT_CODES; code++) {
+        int trit1 = code / (BASE * BASE);
+        int trit2 = (code / BASE) % BASE;
+        int trit3 = code % BASE;
+        table[code] = static_cast<unsigned char>(trit1 | (trit2 << 2) | (trit3 << 4));
+    }
+
+    return table;
+}
+
+alignas(16) static constexpr std::array<unsigned char, 32> PACKED_TRITS = buildPackedTrits();
+
+/**
+ * @brief Returns 0xFF in every lane of the block that holds a letter, 0 elsewhere.
+ */
+DELTA_K_TARGET("avx2")
+static inline __m256i letterLanes(__m256i block) {
+    const __m256i index = _mm256_sub_epi8(_mm256_or_si256(block, _mm256_set1_epi8(0x20)), _mm256_set1_epi8('a'));
+    return _mm256_cmpeq_epi8(_mm256_min_epu8(index, _mm256_set1_epi8(ALPHABET_LENGTH - 1)), index);
+}
+
+/**
+ * @brief Returns a bit per byte of the block, set where the byte is a letter.
+ */
+DELTA_K_TARGET("avx2")
+static inline uint32_t letterMask(__m256i block) {
+    return static_cast<uint32_t>(_mm256_movemask_epi8(letterLanes(block)));
+}
+
+/**
+ * @brief Returns the trit code (1-26) of every letter in the block; other lanes are garbage.
+ */
+DELTA_K_TARGET("avx2")
+static inline __m256i letterCodes(__m256i block) {
+    return _mm256_sub_epi8(_mm256_or_si256(block, _mm256_set1_epi8(0x20)), _mm256_set1_epi8('a' - 1));
+}
+
+/**
+ * @brief The three trits of each lane's trit code, one trit per byte.
+ */
+struct TritVectors {
+    __m256i trit1;
+    __m256i trit2;
+    __m256i trit3;
+};
+
+/**
+ * @brief Splits trit codes (0-26, one per byte) into their three trits with two table shuffles.
+ */
+DELTA_K_TARGET("avx2")
+static inline TritVectors splitTrits(__m256i codes) {
+    // Codes 0-15 hit the low half (16-26 saturate past 0x80 and shuffle in zero),
+    // codes 16-26 hit the high half (0-15 wrap past 0x80).
+    const __m256i lowHalf = _mm256_broadcastsi128_si256(_mm_load_si128(reinterpret_cast<const __m128i*>(PACKED_TRITS.data())));
+    const __m256i highHalf =
+        _mm256_broadcastsi128_si256(_mm_load_si128(reinterpret_cast<const __m128i*>(PACKED_TRITS.data() + 16)));
+    const __m256i packed = _mm256_or_si256(_mm256_shuffle_epi8(lowHalf, _mm256_adds_epu8(codes, _mm256_set1_epi8(0x70))),
+                                           _mm256_shuffle_epi8(highHalf, _mm256_sub_epi8(codes, _mm256_set1_epi8(16))));
+    const __m256i three = _mm256_set1_epi8(3);
+
+    return {_mm256_and_si256(packed, three), _mm256_and_si256(_mm256_srli_epi16(packed, 2), three),
+            _mm256_and_si256(_mm256_srli_epi16(packed, 4), three)};
+}
+
+/**
+ * @brief Expands 16 letters, given as their trits, into 16 glyph triplets (144 bytes) at `out`.
+ *
+ * `half` selects which 128-bit lane of the trit vectors holds the 16 letters. Writes
+ * EXPAND_BYTES bytes; the 16 past the last triplet are garbage for the next store to
+ * overwrite.
+ */
+template <int half>
+DELTA_K_TARGET("avx2")
+static inline void expandTrits(const TritVectors& trits, __m256i glyphBytes, unsigned char* out) {
+    constexpr int lanes = half ? 0x11 : 0x00;
+    const __m256i trit1 = _mm256_permute2x128_si256(trits.trit1, trits.trit1, lanes);
+    const __m256i trit2 = _mm256_permute2x128_si256(trits.trit2, trits.trit2, lanes);
+    const __m256i trit3 = _mm256_permute2x128_si256(trits.trit3, trits.trit3, lanes);
+
+    for (int k = 0; k < EXPAND_BYTES; k += 32) {
+        __m256i gathered = _mm256_or_si256(
+            _mm256_or_si256(
+                _mm256_shuffle_epi8(trit1, _mm256_load_si256(reinterpret_cast<const __m256i*>(EXPAND.gather[0] + k))),
+                _mm256_shuffle_epi8(trit2, _mm256_load_si256(reinterpret_cast<const __m256i*>(EXPAND.gather[1] + k)))),
+            _mm256_shuffle_epi8(trit3, _mm256_load_si256(reinterpret_cast<const __m256i*>(EXPAND.gather[2] + k))));
+        gathered = _mm256_add_epi8(gathered, _mm256_load_si256(reinterpret_cast<const __m256i*>(EXPAND.offset + k)));
+
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(out + k), _mm256_shuffle_epi8(glyphBytes, gathered));
+    }
+}
+
+/**
+ * @brief Expands a block of 32 letters, given as their trits, into 32 triplets (288 bytes).
+ */
+DELTA_K_TARGET("avx2")
+static inline void expandBlock(const TritVectors& trits, __m256i glyphBytes, unsigned char* out) {
+    expandTrits<0>(trits, glyphBytes, out);
+    expandTrits<1>(trits, glyphBytes, out + (EXPAND_LETTERS * TRIPLET_SIZE));
+}
+
+/**
+ * @brief Output offsets for a group of 8 source bytes, indexed by the group's letter mask.
+ *
+ * offset[k] is where byte k's output starts (an exclusive prefix sum of 1 for a
+ * passthrough byte and 9 for a letter); offset[8] is the group's total output length.
+ */
+struct ScatterOffsets {
+    unsigned char offset[ENTRY_WIDTH];
+};
+
+constexpr std::array<ScatterOffsets, 256> buildScatterOffsets() {
+    std::array<ScatterOffsets, 256> table{};
+
+    for (int mask = 0; mask < 256; mask++) {
+        int position = 0;
+        for (int k = 0; k < 8; k++) {
+            table[mask].offset[k] = static_cast<unsigned char>(position);
+            position += ((mask >> k) & 1) ? TRIPLET_SIZE : 1;
+        }
+        table[mask].offset[8] = static_cast<unsigned char>(position);
+    }
+
+    return table;
+}
+
+static constexpr std::array<ScatterOffsets, 256> SCATTER_OFFSETS = buildScatterOffsets();
+
+/**
+ * @brief Writes the table entries of 8 source bytes at their precomputed offsets.
+ *
+ * The offsets do not depend on each other, so the 8 lookups and stores can all be in
+ * flight at once. Stores are issued in order so each entry's padding is overwritten by
+ * the next one.
+ *
+ * @return size_t The group's output length.
+ */
+static inline size_t scatterGroup(const unsigned char* in, unsigned int mask, unsigned char* out) {
+    const ScatterOffsets& offsets = SCATTER_OFFSETS[mask];
+
+    for (int k = 0; k < 8; k++) {
+        std::memcpy(out + offsets.offset[k], &STANDARD_TABLE[in[k]], ENTRY_WIDTH);
+    }
+
+    return offsets.offset[8];
+}
+
+/**
+ * @brief AVX2 letter counter (see countLetters()).
+ *
+ * Letter lanes are 0xFF, so subtracting them counts per lane; the byte counters are
+ * folded into 64-bit totals with vpsadbw before any of them can overflow.
+ *
+ * @param in The source bytes.
+ * @param length The number of source bytes.
+ * @return size_t The number of letters (A-Z, a-z).
+ */
+DELTA_K_TARGET("avx2")
+size_t countLettersAVX2(const unsigned char* in, size_t length) {
+    const __m256i zero = _mm256_setzero_si256();
+    __m256i totals = zero;
+    size_t i = 0;
+
+    while (length - i >= 32) {
+        size_t blocks = (length - i) / 32;
+        if (blocks > 255) blocks = 255;
+
+        __m256i counts = zero;
+        for (size_t b = 0; b < blocks; b++, i += 32) {
+            const __m256i block = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(in + i));
+            counts = _mm256_sub_epi8(counts, letterLanes(block));
+        }
+        totals = _mm256_add_epi64(totals, _mm256_sad_epu8(counts, zero));
+    }
+
+    alignas(32) uint64_t lanes[4];
+    _mm256_store_si256(reinterpret_cast<__m256i*>(lanes), totals);
+
+    return static_cast<size_t>(lanes[0] + lanes[1] + lanes[2] + lanes[3]) + countLetters(in + i, length - i);
+}
+
+/**
+ * @brief AVX2 Standard Mode encoder.
+ *
+ * Classifies 32 source bytes at a time:
+ * - no letters: the block is copied with a single 32-byte store;
+ * - all letters: the block is expanded to glyph triplets entirely with byte shuffles;
+ * - mixed: each group of 8 takes its output offsets (the prefix sum of output widths)
+ *   from SCATTER_OFFSETS and writes its table entries independently.
+ *
+ * Every source byte produces at least one output byte, so while EXPAND_BYTES source
+ * bytes remain the full-width stores stay inside the output. The rest is finished by
+ * the table-driven encodeStandard().
+ *
+ * @param in The source bytes.
+ * @param length The number of source bytes.
+ * @param out The destination; must hold standardEncodedSize(in, length) bytes.
+ * @return size_t The number of bytes written.
+ */
+DELTA_K_TARGET("avx2")
+size_t encodeStandardAVX2(const unsigned char* in, size_t length, unsigned char* out) {
+    unsigned char* start = out;
+    const __m256i glyphBytes = _mm256_load_si256(reinterpret_cast<const __m256i*>(GLYPH_BYTE_LUT));
+    size_t i = 0;
+
+    while (length - i >= EXPAND_BYTES) {
+        const __m256i block = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(in + i));
+        const uint32_t letters = letterMask(block);
+
+        if (letters == 0) {
+            _mm256_storeu_si256(reinterpret_cast<__m256i*>(out), block);
+            out += 32;
+        } else if (letters == 0xFFFFFFFFu) {
+            expandBlock(splitTrits(letterCodes(block)), glyphBytes, out);
+            out += 32 * TRIPLET_SIZE;
+        } else {
+            for (int group = 0; group < 32; group += 8) {
+                out += scatterGroup(in + i + group, (letters >> group) & 0xFF, out);
+            }
+        }
+        i += 32;
+    }
+
+    out += encodeStandard(in + i, length - i, out);
+
+    return static_cast<size_t>(out - start);
+}
+
+/**
+ * @brief (a + b) % 3 for the trit sums 0-4, as a shuffle table.
+ */
+alignas(32) static constexpr unsigned char TRIT_SUM_MOD3[32] = {
+    0, 1, 2, 0, 1, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 1, 2, 0, 1, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0
+};
+
+/**
+ * @brief Adds the trits of two letters lane by lane, modulo 3 (the Delta Mode operation).
+ */
+DELTA_K_TARGET("avx2")
+static inline TritVectors addTrits(const TritVectors& plain, const TritVectors& key) {
+    const __m256i mod3 = _mm256_load_si256(reinterpret_cast<const __m256i*>(TRIT_SUM_MOD3));
+
+    return {_mm256_shuffle_epi8(mod3, _mm256_add_epi8(plain.trit1, key.trit1)),
+            _mm256_shuffle_epi8(mod3, _mm256_add_epi8(plain.trit2, key.trit2)),
+            _mm256_shuffle_epi8(mod3, _mm256_add_epi8(plain.trit3, key.trit3))};
+}
+
+/**
+ * @brief Recombines trits into trit codes (9 * t1 + 3 * t2 + t3), one per byte.
+ * The trits are at most 2, so the 16-bit shifts never carry into the neighbouring byte.
+ */
+DELTA_K_TARGET("avx2")
+static inline __m256i joinTrits(const TritVectors& trits) {
+    const __m256i nines = _mm256_add_epi8(_mm256_slli_epi16(trits.trit1, 3), trits.trit1);
+    const __m256i threes = _mm256_add_epi8(_mm256_slli_epi16(trits.trit2, 1), trits.trit2);
+    return _mm256_add_epi8(_mm256_add_epi8(nines, threes), trits.trit3);
+}
+
+/**
+ * @brief The output bytes one subgroup of 4 source lanes can take: 4 triplets.
+ */
+constexpr int SUBGROUP_BYTES = 4 * TRIPLET_SIZE;
+
+/**
+ * @brief Shuffle controls that encode a subgroup of 4 source lanes in-register, indexed
+ * by the subgroup's letter mask.
+ *
+ * The subgroup arrives as one 16-byte vector: its 4 source bytes, then trit 1, 2 and 3
+ * of each lane. For output byte p, trit[p] picks the trit of the glyph p belongs to in
+ * a letter's triplet and offset[p] adds 3 * (byte within the glyph), so the sum indexes
+ * GLYPH_BYTE_LUT; for a passthrough lane, trit[p] is 0x80 (a zero) and offset[p] is
+ * 9 + lane, where encodeSubgroup() places the source bytes past the glyph bytes.
+ * length[mask] is the subgroup's output length; bytes past it are zero.
+ */
+struct SubgroupShuffles {
+    alignas(16) unsigned char trit[16][48];
+    alignas(16) unsigned char offset[16][48];
+    unsigned char length[16];
+};
+
+constexpr SubgroupShuffles buildSubgroupShuffles() {
+    SubgroupShuffles tables{};
+
+    for (int mask = 0; mask < 16; mask++) {
+        for (int p = 0; p < 48; p++) {
+            tables.trit[mask][p] = 0x80;
+            tables.offset[mask][p] = 0x80;
+        }
+
+        int p = 0;
+        for (int lane = 0; lane < 4; lane++) {
+            if ((mask >> lane) & 1) {
+                for (int j = 0; j < TRIPLET_SIZE; j++, p++) {
+                    tables.trit[mask][p] = static_cast<unsigned char>(4 + (4 * (j / GLYPH_SIZE)) + lane);
+                    tables.offset[mask][p] = static_cast<unsigned char>(BASE * (j % GLYPH_SIZE));
+                }
+            } else {
+                tables.offset[mask][p++] = static_cast<unsigned char>(TRIPLET_SIZE + lane);
+            }
+        }
+        tables.length[mask] = static_cast<unsigned char>(p);
+    }
+
+    return tables;
+}
+
+static constexpr SubgroupShuffles SUBGROUP = buildSubgroupShuffles();
+
+/**
+ * @brief Encodes a subgroup of 4 source lanes (see SubgroupShuffles) at `out`.
+ * Writes 48 bytes; those past the subgroup's length are garbage for the next one to overwrite.
+ *
+ * @param lanes The subgroup's source bytes and trits.
+ * @param bytes GLYPH_BYTE_LUT with the subgroup's source bytes at 9-12.
+ * @return size_t The subgroup's output length.
+ */
+DELTA_K_TARGET("avx2")
+static inline size_t encodeSubgroup(__m128i lanes, __m128i bytes, unsigned int mask, unsigned char* out) {
+    for (int k = 0; k < 48; k += 16) {
+        const __m128i trit = _mm_load_si128(reinterpret_cast<const __m128i*>(SUBGROUP.trit[mask] + k));
+        const __m128i offset = _mm_load_si128(reinterpret_cast<const __m128i*>(SUBGROUP.offset[mask] + k));
+
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(out + k),
+                         _mm_shuffle_epi8(bytes, _mm_add_epi8(_mm_shuffle_epi8(lanes, trit), offset)));
+    }
+
+    return SUBGROUP.length[mask];
+}
+
+/**
+ * @brief Encodes a block of 32 source bytes that mixes letters and passthrough bytes,
+ * given the trits of its letters, entirely in-register.
+ *
+ * The block's source bytes and trits are transposed so each subgroup of 4 lanes sits
+ * in one 16-byte vector, which encodeSubgroup() expands through SubgroupShuffles.
+ *
+ * @return size_t The block's output length.
+ */
+DELTA_K_TARGET("avx2")
+static inline size_t encodeMixedBlock(__m256i block, const TritVectors& trits, uint32_t letters,
+                                      unsigned char* out) {
+    const __m256i glyphBytes = _mm256_load_si256(reinterpret_cast<const __m256i*>(GLYPH_BYTE_LUT));
+    const __m256i sourceBytes = _mm256_setr_epi32(-1, 0, 0, 0, -1, 0, 0, 0);
+    const __m256i rawLow = _mm256_unpacklo_epi32(block, trits.trit1);
+    const __m256i rawHigh = _mm256_unpackhi_epi32(block, trits.trit1);
+    const __m256i tritLow = _mm256_unpacklo_epi32(trits.trit2, trits.trit3);
+    const __m256i tritHigh = _mm256_unpackhi_epi32(trits.trit2, trits.trit3);
+    // Each vector holds subgroup s in its low 128-bit lane and subgroup s + 4 in its high one.
+    const __m256i subgroups[4] = {_mm256_unpacklo_epi64(rawLow, tritLow), _mm256_unpackhi_epi64(rawLow, tritLow),
+                                  _mm256_unpacklo_epi64(rawHigh, tritHigh),
+                                  _mm256_unpackhi_epi64(rawHigh, tritHigh)};
+    __m256i bytes[4];
+    unsigned char* start = out;
+
+    for (int s = 0; s < 4; s++) {
+        bytes[s] = _mm256_or_si256(glyphBytes,
+                                   _mm256_slli_si256(_mm256_and_si256(subgroups[s], sourceBytes), TRIPLET_SIZE));
+    }
+    for (int s = 0; s < 4; s++) {
+        out += encodeSubgroup(_mm256_castsi256_si128(subgroups[s]), _mm256_castsi256_si128(bytes[s]),
+                              (letters >> (4 * s)) & 0xF, out);
+    }
+    for (int s = 0; s < 4; s++) {
+        out += encodeSubgroup(_mm256_extracti128_si256(subgroups[s], 1), _mm256_extracti128_si256(bytes[s], 1),
+                              (letters >> (16 + (4 * s))) & 0xF, out);
+    }
+
+    return static_cast<size_t>(out - start);
+}
+
+/**
+ * @brief Computes each letter's ordinal within the block: an in-register exclusive
+ * prefix sum of the letter flags across all 32 lanes.
+ */
+DELTA_K_TARGET("avx2")
+static inline __m256i letterOrdinals(__m256i isLetter) {
+    const __m256i flags = _mm256_and_si256(isLetter, _mm256_set1_epi8(1));
+
+    __m256i sum = _mm256_add_epi8(flags, _mm256_slli_si256(flags, 1));
+    sum = _mm256_add_epi8(sum, _mm256_slli_si256(sum, 2));
+    sum = _mm256_add_epi8(sum, _mm256_slli_si256(sum, 4));
+    sum = _mm256_add_epi8(sum, _mm256_slli_si256(sum, 8));
+
+    // The byte shifts stay within each 128-bit lane, so carry the low lane's total into the high lane.
+    const __m256i lowTotal = _mm256_shuffle_epi8(_mm256_permute2x128_si256(sum, sum, 0x08), _mm256_set1_epi8(15));
+    sum = _mm256_add_epi8(sum, lowTotal);
+
+    return _mm256_sub_epi8(sum, flags);
+}
+
+/**
+ * @brief Picks each letter's key code out of the 32-code key window by its ordinal.
+ */
+DELTA_K_TARGET("avx2")
+static inline __m256i selectKeyCodes(__m256i window, __m256i ordinals) {
+    const __m256i low = _mm256_permute2x128_si256(window, window, 0x00);
+    const __m256i high = _mm256_permute2x128_si256(window, window, 0x11);
+    const __m256i fromHigh = _mm256_cmpgt_epi8(ordinals, _mm256_set1_epi8(15));
+
+    return _mm256_blendv_epi8(_mm256_shuffle_epi8(low, ordinals), _mm256_shuffle_epi8(high, ordinals), fromHigh);
+}
+
+/**
+ * @brief AVX2 Delta Mode encoder.
+ *
+ * The key only advances on letters, so it cannot simply be tiled across lanes. Instead
+ * the key pattern repeats past its end (see DeltaKey), so the 32 codes following any
+ * key position can be loaded as one window, and for each 32-byte block every letter's ordinal (an
+ * in-register prefix sum of the letter flags) selects its key code out of that window.
+ * The trit addition then runs on all lanes at once through shuffle tables:
+ * - no letters: the block is copied with a single 32-byte store;
+ * - all letters: the keyed trits are expanded to glyph triplets with byte shuffles;
+ * - mixed: the keyed trits and the passthrough bytes are expanded in-register, 4 lanes
+ *   at a time, by encodeMixedBlock().
+ * The tail is finished by the table-driven encodeKeyed(), with identical semantics.
+ *
+ * @param in The source bytes.
+ * @param length The number of source bytes.
+ * @param key The key's trit codes, repeated past keyLength (see DeltaKey::codes()).
+ * @param keyLength The number of key codes; must be non-zero.
+ * @param keyIndex The key position of the first letter in `in` (less than keyLength).
+ * @param out The destination; must hold standardEncodedSize(in, length) bytes.
+ * @return size_t The number of bytes written.
+ */
+DELTA_K_TARGET("avx2,popcnt")
+size_t encodeKeyedAVX2(const unsigned char* in, size_t length, const unsigned char* key, size_t keyLength,
+                       size_t keyIndex, unsigned char* out) {
+    unsigned char* start = out;
+    const __m256i glyphBytes = _mm256_load_si256(reinterpret_cast<const __m256i*>(GLYPH_BYTE_LUT));
+    size_t i = 0;
+
+    while (length - i >= EXPAND_BYTES) {
+        const __m256i block = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(in + i));
+        const __m256i isLetter = letterLanes(block);
+        const uint32_t letters = static_cast<uint32_t>(_mm256_movemask_epi8(isLetter));
+
+        if (letters == 0) {
+            _mm256_storeu_si256(reinterpret_cast<__m256i*>(out), block);
+            out += 32;
+            i += 32;
+            continue;
+        }
+
+        const __m256i window = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(key + keyIndex));
+        const __m256i keyed = letters == 0xFFFFFFFFu ? window : selectKeyCodes(window, letterOrdinals(isLetter));
+        const TritVectors trits = addTrits(splitTrits(letterCodes(block)), splitTrits(keyed));
+
+        if (letters == 0xFFFFFFFFu) {
+            expandBlock(trits, glyphBytes, out);
+            out += 32 * TRIPLET_SIZE;
+        } else {
+            out += encodeMixedBlock(block, trits, letters, out);
+        }
+
+        keyIndex += countBits(letters);
+        if (keyIndex >= keyLength) keyIndex %= keyLength;
+        i += 32;
+    }
+
+    out += encodeKeyed(in + i, length - i, key, keyLength, keyIndex, out);
+
+    return static_cast<size_t>(out - start);
+}
+
+/**
+ * @brief Returns a bit per byte of the 64 bytes at `in`, set where a valid glyph starts.
+ */
+DELTA_K_TARGET("avx2")
+static inline uint64_t glyphStarts256(const unsigned char* in) {
+    uint64_t starts = 0;
+
+    for (size_t c = 0; c < DECODE_BLOCK_BYTES; c += 32) {
+        const __m256i first = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(in + c));
+        const __m256i second = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(in + c + 1));
+        const __m256i third = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(in + c + 2));
+
+        const __m256i lead = _mm256_cmpeq_epi8(first, _mm256_set1_epi8(static_cast<char>(0xE2)));
+        const __m256i middle96 = _mm256_cmpeq_epi8(second, _mm256_set1_epi8(static_cast<char>(0x96)));
+        const __m256i middle97 = _mm256_cmpeq_epi8(second, _mm256_set1_epi8(static_cast<char>(0x97)));
+        const __m256i finalB2BC =
+            _mm256_or_si256(_mm256_cmpeq_epi8(third, _mm256_set1_epi8(static_cast<char>(0xB2))),
+                            _mm256_cmpeq_epi8(third, _mm256_set1_epi8(static_cast<char>(0xBC))));
+        const __m256i final86 = _mm256_cmpeq_epi8(third, _mm256_set1_epi8(static_cast<char>(0x86)));
+        const __m256i valid = _mm256_and_si256(
+            lead, _mm256_or_si256(_mm256_and_si256(middle96, finalB2BC), _mm256_and_si256(middle97, final86)));
+
+        starts |= static_cast<uint64_t>(static_cast<uint32_t>(_mm256_movemask_epi8(valid))) << c;
+    }
+
+    return starts;
+}
+
+/**
+ * @brief Returns the trit of the glyph whose final byte is in each lane.
+ */
+DELTA_K_TARGET("avx2")
+static inline __m256i finalTrits(const unsigned char* in) {
+    const __m256i bytes = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(in));
+    const __m256i nibbleTrits =
+        _mm256_broadcastsi128_si256(_mm_loadu_si128(reinterpret_cast<const __m128i*>(FINAL_NIBBLE_TRIT)));
+    return _mm256_shuffle_epi8(nibbleTrits, _mm256_and_si256(bytes, _mm256_set1_epi8(0x0F)));
+}
+
+/**
+ * @brief Returns 0xFF in the lanes whose bit is set in a 32-bit mask.
+ */
+DELTA_K_TARGET("avx2")
+static inline __m256i maskLanes(uint32_t bits) {
+    const __m256i select = _mm256_set1_epi64x(static_cast<long long>(0x8040201008040201ULL));
+    const __m256i spread = _mm256_shuffle_epi8(_mm256_set1_epi32(static_cast<int>(bits)),
+                                               _mm256_setr_epi64x(0, 0x0101010101010101LL, 0x0202020202020202LL,
+                                                                  0x0303030303030303LL));
+    return _mm256_cmpeq_epi8(_mm256_and_si256(spread, select), select);
+}
+
+/**
+ * @brief Loads the shuffle controls for two groups of 8 lanes into one 128-bit lane's control.
+ */
+DELTA_K_TARGET("avx2")
+static inline __m128i laneShuffle(const LaneShuffle& low, const LaneShuffle& high) {
+    return _mm_unpacklo_epi64(_mm_loadl_epi64(reinterpret_cast<const __m128i*>(low.lanes)),
+                              _mm_add_epi8(_mm_loadl_epi64(reinterpret_cast<const __m128i*>(high.lanes)),
+                                           _mm_set1_epi8(8)));
+}
+
+/**
+ * @brief Shared AVX2 decode loop for both modes, 64 ciphertext bytes per block.
+ *
+ * The same block parse as the SSE4.2 decoder (see parseGlyphBlock()) on 32 lanes at a
+ * time: glyph starts are validated in-register, every lane computes the letter of a
+ * triplet starting there from the final bytes 2, 5 and 8 lanes on (offset by the
+ * negated key trits in Delta Mode, spread to the groups of 8 lanes that hold a triplet
+ * start), the letters replace the triplet starts and the kept bytes are packed 8 lanes
+ * at a time through COMPACT_SHUFFLES. Blocks without glyphs are copied whole, and
+ * decodeStandard() or decodeKeyed() finishes the tail.
+ */
+DELTA_K_TARGET("avx2,popcnt")
+static size_t decodeAVX2(const unsigned char* in, size_t length, const unsigned char* key, size_t keyLength,
+                         size_t keyIndex, unsigned char* out) {
+    unsigned char* start = out;
+    const __m256i letterBase = _mm256_set1_epi8('A' - 1);
+    const __m256i mod3 = _mm256_broadcastsi128_si256(_mm_setr_epi8(0, 1, 2, 0, 1, 2, 0, 1, 2, 0, 1, 2, 0, 1, 2, 0));
+    GlyphCarry carry;
+    size_t i = 0;
+    uint64_t starts = length >= DECODE_BLOCK_MARGIN ? glyphStarts256(in) : 0;
+
+    for (; length - i >= DECODE_BLOCK_MARGIN; i += DECODE_BLOCK_BYTES) {
+        const uint64_t nextStarts = glyphStarts256(in + i + DECODE_BLOCK_BYTES);
+        const GlyphBlock block = parseGlyphBlock(starts, nextStarts, carry);
+        starts = nextStarts;
+
+        if (block.keep == ~uint64_t{0} && block.triplets == 0) {
+            for (size_t c = 0; c < DECODE_BLOCK_BYTES; c += 32) {
+                _mm256_storeu_si256(reinterpret_cast<__m256i*>(out + c),
+                                    _mm256_loadu_si256(reinterpret_cast<const __m256i*>(in + i + c)));
+            }
+            out += DECODE_BLOCK_BYTES;
+            continue;
+        }
+
+        __m256i groupKeys[BASE];
+        if (key) {
+            const __m128i spread = _mm_loadl_epi64(
+                reinterpret_cast<const __m128i*>(SPREAD_SHUFFLES[occupiedGroups(block.triplets)].lanes));
+            for (int g = 0; g < BASE; g++) {
+                const __m128i negated =
+                    _mm_loadl_epi64(reinterpret_cast<const __m128i*>(negatedKeyTrits(key, keyLength, g) + keyIndex));
+                groupKeys[g] = _mm256_broadcastsi128_si256(_mm_shuffle_epi8(negated, spread));
+            }
+            keyIndex += countBits64(block.triplets);
+            if (keyIndex >= keyLength) keyIndex %= keyLength;
+        }
+
+        for (size_t c = 0; c < DECODE_BLOCK_BYTES; c += 32) {
+            const unsigned char* chunk = in + i + c;
+            __m256i trits[BASE] = {finalTrits(chunk + 2), finalTrits(chunk + 5), finalTrits(chunk + 8)};
+
+            if (key) {
+                const long long group = static_cast<long long>(c / 8);
+                const __m256i broadcast = _mm256_setr_epi64x(
+                    0x0101010101010101LL * group, 0x0101010101010101LL * (group + 1),
+                    0x0101010101010101LL * (group + 2), 0x0101010101010101LL * (group + 3));
+                for (int g = 0; g < BASE; g++) {
+                    trits[g] = _mm256_shuffle_epi8(
+                        mod3, _mm256_add_epi8(trits[g], _mm256_shuffle_epi8(groupKeys[g], broadcast)));
+                }
+            }
+
+            const TritVectors joined = {trits[0], trits[1], trits[2]};
+            const uint32_t triplets = static_cast<uint32_t>(block.triplets >> c);
+            const uint32_t keep = static_cast<uint32_t>(block.keep >> c);
+            const __m256i bytes =
+                _mm256_blendv_epi8(_mm256_loadu_si256(reinterpret_cast<const __m256i*>(chunk)),
+                                   _mm256_add_epi8(joinTrits(joined), letterBase), maskLanes(triplets));
+            const __m256i control = _mm256_set_m128i(
+                laneShuffle(COMPACT_SHUFFLES[(keep >> 16) & 0xFF], COMPACT_SHUFFLES[keep >> 24]),
+                laneShuffle(COMPACT_SHUFFLES[keep & 0xFF], COMPACT_SHUFFLES[(keep >> 8) & 0xFF]));
+            const __m256i packed = _mm256_shuffle_epi8(bytes, control);
+            const __m128i low = _mm256_castsi256_si128(packed);
+            const __m128i high = _mm256_extracti128_si256(packed, 1);
+
+            _mm_storel_epi64(reinterpret_cast<__m128i*>(out), low);
+            out += countBits(keep & 0xFF);
+            _mm_storel_epi64(reinterpret_cast<__m128i*>(out), _mm_unpackhi_epi64(low, low));
+            out += countBits((keep >> 8) & 0xFF);
+            _mm_storel_epi64(reinterpret_cast<__m128i*>(out), high);
+            out += countBits((keep >> 16) & 0xFF);
+            _mm_storel_epi64(reinterpret_cast<__m128i*>(out), _mm_unpackhi_epi64(high, high));
+            out += countBits(keep >> 24);
+        }
+    }
+
+    i += glyphSpill(carry);
+
+    if (key) {
+        out += decodeKeyed(in + i, length - i, key, keyLength, keyIndex, out);
+    } else {
+        out += decodeStandard(in + i, length - i, out);
+    }
+
+    return static_cast<size_t>(out - start);
+}
+
+/**
+ * @brief AVX2 Standard Mode decoder (see decodeAVX2()).
+ *
+ * @param in The ciphertext bytes.
+ * @param length The number of ciphertext bytes.
+ * @param out The destination; must hold `length` bytes.
+ * @return size_t The number of bytes written.
+ */
+size_t decodeStandardAVX2(const unsigned char* in, size_t length, unsigned char* out) {
+    return decodeAVX2(in, length, nullptr, 0, 0, out);
+}
+
+/**
+ * @brief AVX2 Delta Mode decoder (see decodeAVX2()).
+ *
+ * @param in The ciphertext bytes.
+ * @param length The number of ciphertext bytes.
+ * @param key The key's trit codes, repeated past keyLength (see DeltaKey::codes()).
+ * @param keyLength The number of key codes; must be non-zero.
+ * @param keyIndex The key position of the first triplet in `in` (less than keyLength).
+ * @param out The destination; must hold `length` bytes.
+ * @return size_t The number of bytes written.
+ */
+size_t decodeKeyedAVX2(const unsigned char* in, size_t length, const unsigned char* key, size_t keyLength,
+                       size_t keyIndex, unsigned char* out) {
+    return decodeAVX2(in, length, key, keyLength, keyIndex, out);
+}
+
+#else
+
+size_t countLettersAVX2(const unsigned char* in, size_t length) {
+    return countLetters(in, length);
+}
+
+size_t encodeStandardAVX2(const unsigned char* in, size_t length, unsigned char* out) {
+    return encodeStandard(in, length, out);
+}
+
+size_t decodeStandardAVX2(const unsigned char* in, size_t length, unsigned char* out) {
+    return decodeStandard(in, length, out);
+}
+
+size_t encodeKeyedAVX2(const unsigned char* in, size_t length, const unsigned char* key, size_t keyLength,
+                       size_t keyIndex, unsigned char* out) {
+    return encodeKeyed(in, length, key, keyLength, keyIndex, out);
+}
+
+size_t decodeKeyedAVX2(const unsigned char* in, size_t length, const unsigned char* key, size_t keyLength,
+                       size_t keyIndex, unsigned char* out) {
+    return decodeKeyed(in, length, key, keyLength, keyIndex, out);
+}
+
+#endif
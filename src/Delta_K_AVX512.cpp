@@ -0,0 +1,450 @@
+#include "Delta_K_Engine.hpp"
+#include "Delta_K_Kernels.hpp"
+#include "Delta_K_Tables.hpp"
+
+#include <array>
+#include <cstdint>
+
+#ifdef DELTA_K_X86
+#include <immintrin.h>
+#endif
+
+/**
+ * @brief Checks whether the CPU (and OS) support the AVX-512 VBMI/VBMI2 kernel tier.
+ * The kernels also use BMI2 (pdep/pext) for mask arithmetic.
+ *
+ * @return true If the AVX-512 kernels can run on this host.
+ */
+bool cpuHasAVX512VBMI2() {
+#if defined(DELTA_K_X86) && (defined(__GNUC__) || defined(__clang__))
+    return __builtin_cpu_supports("avx512f") && __builtin_cpu_supports("avx512bw") &&
+           __builtin_cpu_supports("avx512vbmi") && __builtin_cpu_supports("avx512vbmi2") &&
+           __builtin_cpu_supports("bmi2");
+#elif defined(DELTA_K_X86) && defined(_MSC_VER)
+    int info[4];
+    __cpuid(info, 1);
+    bool osSavesZmm = (info[2] & (1 << 27)) && ((_xgetbv(0) & 0xE6) == 0xE6);
+    __cpuidex(info, 7, 0);
+    bool features = (info[1] & (1 << 16)) && (info[1] & (1 << 30)) && (info[1] & (1 << 8)) &&
+                    (info[2] & (1 << 1)) && (info[2] & (1 << 6));
+    return osSavesZmm && features;
+#else
+    return false;
+#endif
+}
+
+#if defined(DELTA_K_X86) && (defined(__x86_64__) || defined(_M_X64))
+
+#define DELTA_K_AVX512 "avx512f,avx512bw,avx512vbmi,avx512vbmi2,bmi,bmi2,popcnt"
+
+/**
+ * @brief The source bytes one encode step consumes: 9 groups of 7 letters fill 63-byte slot vectors.
+ */
+constexpr int ENCODE_BLOCK = 63;
+
+/**
+ * @brief The source lanes one slot vector covers (7 lanes of 9 slots each).
+ */
+constexpr int GROUP_LANES = 7;
+
+/**
+ * @brief Bit 9j set for each of the 7 lanes of a slot vector: the slot every source byte keeps.
+ */
+constexpr uint64_t FIRST_SLOTS = 0x0040201008040201ULL;
+
+/**
+ * @brief Constant byte vectors for the slot-based 1 -> 9 expansion.
+ *
+ * Slot q of a slot vector belongs to source lane q / 9 of its group, glyph (q % 9) / 3,
+ * and byte q % 3 of that glyph.
+ * - slotLane[k][q] is the block lane feeding slot q of group k;
+ * - slotTrit[q] is 32 * glyph, the row of tritRows to read the slot's trit from;
+ * - slotByte[q] is 3 * byte, so trit + slotByte[q] indexes the glyph byte table.
+ * finalTrits repeats FINAL_NIBBLE_TRIT in every 128-bit lane, ready for vpshufb.
+ */
+struct AVX512Tables {
+    alignas(64) unsigned char slotLane[ENCODE_BLOCK / GROUP_LANES][64];
+    alignas(64) unsigned char slotTrit[64];
+    alignas(64) unsigned char slotByte[64];
+    alignas(64) unsigned char tritRows[128];
+    alignas(64) unsigned char glyphBytes[64];
+    alignas(64) unsigned char mod3[64];
+    alignas(64) unsigned char finalTrits[64];
+};
+
+constexpr AVX512Tables buildAVX512Tables() {
+    AVX512Tables tables{};
+
+    for (int q = 0; q < 64; q++) {
+        int lane = q / TRIPLET_SIZE;
+        int glyph = (q % TRIPLET_SIZE) / GLYPH_SIZE;
+
+        for (int k = 0; k < ENCODE_BLOCK / GROUP_LANES; k++) {
+            tables.slotLane[k][q] = static_cast<unsigned char>((k * GROUP_LANES) + (lane < GROUP_LANES ? lane : 0));
+        }
+        tables.slotTrit[q] = static_cast<unsigned char>(32 * (glyph % BASE));
+        tables.slotByte[q] = static_cast<unsigned char>(BASE * (q % GLYPH_SIZE));
+    }
+
+    // Row g (32 entries) holds trit g of every trit code.
+    for (int code = 0; code < TRIT_CODES; code++) {
+        tables.tritRows[code] = static_cast<unsigned char>(code / (BASE * BASE));
+        tables.tritRows[32 + code] = static_cast<unsigned char>((code / BASE) % BASE);
+        tables.tritRows[64 + code] = static_cast<unsigned char>(code % BASE);
+    }
+
+    const unsigned char glyphBytes[TRIPLET_SIZE] = {0xE2, 0xE2, 0xE2, 0x96, 0x96, 0x97, 0xB2, 0xBC, 0x86};
+    for (int q = 0; q < 64; q++) {
+        tables.glyphBytes[q] = (q % 16) < TRIPLET_SIZE ? glyphBytes[q % 16] : 0;
+        tables.mod3[q] = static_cast<unsigned char>((q % 16) % BASE);
+        tables.finalTrits[q] = FINAL_NIBBLE_TRIT[q % 16];
+    }
+
+    return tables;
+}
+
+static constexpr AVX512Tables TABLES512 = buildAVX512Tables();
+
+DELTA_K_TARGET(DELTA_K_AVX512)
+static inline __m512i load512(const unsigned char* p) {
+    return _mm512_load_si512(reinterpret_cast<const void*>(p));
+}
+
+/**
+ * @brief Returns lane index[i] of `table` in every lane i (vpermb).
+ * GCC 12 implements the unmasked intrinsic with an _mm512_undefined_epi32() source,
+ * which -Wmaybe-uninitialized reports once inlined; the zero-masked form with every
+ * lane selected compiles to the same instruction.
+ */
+DELTA_K_TARGET(DELTA_K_AVX512)
+static inline __m512i permuteBytes512(__m512i index, __m512i table) {
+    return _mm512_maskz_permutexvar_epi8(~__mmask64{0}, index, table);
+}
+
+/**
+ * @brief Returns a mask of the lowest `count` bits (count < 64).
+ */
+static inline uint64_t lowBits(unsigned count) {
+    return (uint64_t{1} << count) - 1;
+}
+
+/**
+ * @brief Returns a bit per byte of the block, set where the byte is a letter.
+ */
+DELTA_K_TARGET(DELTA_K_AVX512)
+static inline uint64_t letterMask512(__m512i block) {
+    const __m512i index = _mm512_sub_epi8(_mm512_or_si512(block, _mm512_set1_epi8(0x20)), _mm512_set1_epi8('a'));
+    return _mm512_cmplt_epu8_mask(index, _mm512_set1_epi8(ALPHABET_LENGTH));
+}
+
+/**
+ * @brief Returns the trit code (1-26) of every letter in the block; other lanes are garbage.
+ */
+DELTA_K_TARGET(DELTA_K_AVX512)
+static inline __m512i letterCodes512(__m512i block) {
+    return _mm512_sub_epi8(_mm512_or_si512(block, _mm512_set1_epi8(0x20)), _mm512_set1_epi8('a' - 1));
+}
+
+/**
+ * @brief Reads trit `row` (0-2) of every lane's trit code.
+ */
+DELTA_K_TARGET(DELTA_K_AVX512)
+static inline __m512i tritOf(__m512i codes, int row) {
+    const __m512i index = _mm512_add_epi8(codes, _mm512_set1_epi8(static_cast<char>(32 * row)));
+    return _mm512_permutex2var_epi8(load512(TABLES512.tritRows), index, load512(TABLES512.tritRows + 64));
+}
+
+/**
+ * @brief Recombines three trit vectors into trit codes (9 * t1 + 3 * t2 + t3).
+ * The trits are at most 2, so the 16-bit shifts never carry into the neighbouring byte.
+ */
+DELTA_K_TARGET(DELTA_K_AVX512)
+static inline __m512i joinTrits512(__m512i trit1, __m512i trit2, __m512i trit3) {
+    const __m512i nines = _mm512_add_epi8(_mm512_slli_epi16(trit1, 3), trit1);
+    const __m512i threes = _mm512_add_epi8(_mm512_slli_epi16(trit2, 1), trit2);
+    return _mm512_add_epi8(_mm512_add_epi8(nines, threes), trit3);
+}
+
+/**
+ * @brief Adds two trit codes per lane digit by digit, modulo 3 (see tritAdd()).
+ */
+DELTA_K_TARGET(DELTA_K_AVX512)
+static inline __m512i addCodes512(__m512i a, __m512i b) {
+    const __m512i mod3 = load512(TABLES512.mod3);
+    __m512i trits[BASE];
+
+    for (int row = 0; row < BASE; row++) {
+        trits[row] = _mm512_shuffle_epi8(mod3, _mm512_add_epi8(tritOf(a, row), tritOf(b, row)));
+    }
+
+    return joinTrits512(trits[0], trits[1], trits[2]);
+}
+
+/**
+ * @brief Expands one 63-byte block into the output using slot vectors and vpcompressb.
+ *
+ * Each group of 7 source lanes is spread over a 63-slot vector with vpermb (9 slots per
+ * lane). Letter lanes fill all 9 slots with their glyph bytes, passthrough lanes keep
+ * their byte in the first slot, and vpcompressb squeezes out the unused slots.
+ *
+ * @param block The source bytes.
+ * @param codes The trit code of the glyph triplet each letter lane encodes to.
+ * @param letters The letter mask of the block (lanes 0-62).
+ * @param out The destination; written with exact-length masked stores.
+ * @return unsigned char* The position after the last byte written.
+ */
+DELTA_K_TARGET(DELTA_K_AVX512)
+static inline unsigned char* expandBlock512(__m512i block, __m512i codes, uint64_t letters, unsigned char* out) {
+    const __m512i glyphBytes = load512(TABLES512.glyphBytes);
+    const __m512i slotTrit = load512(TABLES512.slotTrit);
+    const __m512i slotByte = load512(TABLES512.slotByte);
+    const __m512i tritLow = load512(TABLES512.tritRows);
+    const __m512i tritHigh = load512(TABLES512.tritRows + 64);
+
+    for (int k = 0; k < ENCODE_BLOCK / GROUP_LANES; k++) {
+        const __m512i lanes = load512(TABLES512.slotLane[k]);
+        const __m512i slotCodes = permuteBytes512(lanes, codes);
+        const __m512i slotBytes = permuteBytes512(lanes, block);
+        const __m512i trits = _mm512_permutex2var_epi8(tritLow, _mm512_add_epi8(slotCodes, slotTrit), tritHigh);
+        const __m512i glyphs = _mm512_shuffle_epi8(glyphBytes, _mm512_add_epi8(trits, slotByte));
+
+        const uint64_t letterSlots = _pdep_u64((letters >> (k * GROUP_LANES)) & 0x7F, FIRST_SLOTS) * 0x1FF;
+        const uint64_t keep = letterSlots | FIRST_SLOTS;
+        const __m512i packed = _mm512_maskz_compress_epi8(keep, _mm512_mask_blend_epi8(letterSlots, slotBytes, glyphs));
+        const unsigned written = static_cast<unsigned>(_mm_popcnt_u64(keep));
+
+        _mm512_mask_storeu_epi8(out, lowBits(written), packed);
+        out += written;
+    }
+
+    return out;
+}
+
+/**
+ * @brief AVX-512 VBMI2 Standard Mode encoder.
+ *
+ * Blocks without letters are copied 64 bytes at a time; every other block of 63 bytes
+ * goes through expandBlock512(), which handles letters and passthrough bytes alike.
+ * encodeStandard() finishes the tail.
+ *
+ * @param in The source bytes.
+ * @param length The number of source bytes.
+ * @param out The destination; must hold standardEncodedSize(in, length) bytes.
+ * @return size_t The number of bytes written.
+ */
+DELTA_K_TARGET(DELTA_K_AVX512)
+size_t encodeStandardAVX512(const unsigned char* in, size_t length, unsigned char* out) {
+    unsigned char* start = out;
+    size_t i = 0;
+
+    while (length - i >= 64) {
+        const __m512i block = _mm512_loadu_si512(reinterpret_cast<const void*>(in + i));
+        const uint64_t letters = letterMask512(block);
+
+        if (letters == 0) {
+            _mm512_storeu_si512(reinterpret_cast<void*>(out), block);
+            out += 64;
+            i += 64;
+            continue;
+        }
+
+        out = expandBlock512(block, letterCodes512(block), letters & lowBits(ENCODE_BLOCK), out);
+        i += ENCODE_BLOCK;
+    }
+
+    out += encodeStandard(in + i, length - i, out);
+
+    return static_cast<size_t>(out - start);
+}
+
+/**
+ * @brief AVX-512 VBMI2 Delta Mode encoder.
+ *
+ * vpexpandb places consecutive codes of the key pattern (see DeltaKey) exactly at the
+ * block's letter lanes, so no prefix sum is needed to align the key. The trit addition
+ * runs on all lanes through table shuffles and the keyed codes are expanded like the
+ * Standard Mode kernel. encodeKeyed() finishes the tail.
+ *
+ * @param in The source bytes.
+ * @param length The number of source bytes.
+ * @param key The key's trit codes, repeated past keyLength (see DeltaKey::codes()).
+ * @param keyLength The number of key codes; must be non-zero.
+ * @param keyIndex The key position of the first letter in `in` (less than keyLength).
+ * @param out The destination; must hold standardEncodedSize(in, length) bytes.
+ * @return size_t The number of bytes written.
+ */
+DELTA_K_TARGET(DELTA_K_AVX512)
+size_t encodeKeyedAVX512(const unsigned char* in, size_t length, const unsigned char* key, size_t keyLength,
+                         size_t keyIndex, unsigned char* out) {
+    unsigned char* start = out;
+    size_t i = 0;
+
+    while (length - i >= 64) {
+        const __m512i block = _mm512_loadu_si512(reinterpret_cast<const void*>(in + i));
+        uint64_t letters = letterMask512(block);
+
+        if (letters == 0) {
+            _mm512_storeu_si512(reinterpret_cast<void*>(out), block);
+            out += 64;
+            i += 64;
+            continue;
+        }
+
+        letters &= lowBits(ENCODE_BLOCK);
+        const __m512i window = _mm512_loadu_si512(reinterpret_cast<const void*>(key + keyIndex));
+        const __m512i keyed = addCodes512(letterCodes512(block), _mm512_maskz_expand_epi8(letters, window));
+
+        out = expandBlock512(block, keyed, letters, out);
+
+        keyIndex += static_cast<size_t>(_mm_popcnt_u64(letters));
+        if (keyIndex >= keyLength) keyIndex %= keyLength;
+        i += ENCODE_BLOCK;
+    }
+
+    out += encodeKeyed(in + i, length - i, key, keyLength, keyIndex, out);
+
+    return static_cast<size_t>(out - start);
+}
+
+/**
+ * @brief Returns a bit per byte of the 64 bytes at `in`, set where a valid glyph starts.
+ */
+DELTA_K_TARGET(DELTA_K_AVX512)
+static inline uint64_t glyphStarts512(const unsigned char* in) {
+    const __m512i first = _mm512_loadu_si512(reinterpret_cast<const void*>(in));
+    const __m512i second = _mm512_loadu_si512(reinterpret_cast<const void*>(in + 1));
+    const __m512i third = _mm512_loadu_si512(reinterpret_cast<const void*>(in + 2));
+
+    const uint64_t leads = _mm512_cmpeq_epi8_mask(first, _mm512_set1_epi8(static_cast<char>(0xE2)));
+    const uint64_t middle96 = _mm512_cmpeq_epi8_mask(second, _mm512_set1_epi8(static_cast<char>(0x96)));
+    const uint64_t middle97 = _mm512_cmpeq_epi8_mask(second, _mm512_set1_epi8(static_cast<char>(0x97)));
+    const uint64_t finalB2 = _mm512_cmpeq_epi8_mask(third, _mm512_set1_epi8(static_cast<char>(0xB2)));
+    const uint64_t finalBC = _mm512_cmpeq_epi8_mask(third, _mm512_set1_epi8(static_cast<char>(0xBC)));
+    const uint64_t final86 = _mm512_cmpeq_epi8_mask(third, _mm512_set1_epi8(static_cast<char>(0x86)));
+
+    return leads & ((middle96 & (finalB2 | finalBC)) | (middle97 & final86));
+}
+
+/**
+ * @brief Returns the trit of the glyph whose final byte is in each lane, read from the
+ * low nibble of the 64 bytes at `in`.
+ */
+DELTA_K_TARGET(DELTA_K_AVX512)
+static inline __m512i finalTrits512(const unsigned char* in) {
+    const __m512i bytes = _mm512_loadu_si512(reinterpret_cast<const void*>(in));
+    return _mm512_shuffle_epi8(load512(TABLES512.finalTrits), _mm512_and_si512(bytes, _mm512_set1_epi8(0x0F)));
+}
+
+/**
+ * @brief Shared AVX-512 decode loop for both modes, 64 ciphertext bytes per block.
+ *
+ * The same block parse as the SSE4.2 and AVX2 decoders (see parseGlyphBlock()) on all
+ * 64 lanes at once. Every lane computes the letter of a triplet starting there from the
+ * final bytes 2, 5 and 8 lanes on; in Delta Mode vpexpandb places consecutive negated
+ * key trits (3 - k, see negatedKeyTrits()) exactly at the triplet starts. The letters
+ * are blended over the triplet starts and vpcompressb packs the kept bytes with one
+ * store. Blocks without glyphs are copied whole, and decodeStandard() or decodeKeyed()
+ * finishes the tail.
+ */
+DELTA_K_TARGET(DELTA_K_AVX512)
+static size_t decodeAVX512(const unsigned char* in, size_t length, const unsigned char* key, size_t keyLength,
+                           size_t keyIndex, unsigned char* out) {
+    unsigned char* start = out;
+    const __m512i mod3 = load512(TABLES512.mod3);
+    GlyphCarry carry;
+    size_t i = 0;
+    uint64_t starts = length >= DECODE_BLOCK_MARGIN ? glyphStarts512(in) : 0;
+
+    for (; length - i >= DECODE_BLOCK_MARGIN; i += DECODE_BLOCK_BYTES) {
+        const uint64_t nextStarts = glyphStarts512(in + i + DECODE_BLOCK_BYTES);
+        const GlyphBlock block = parseGlyphBlock(starts, nextStarts, carry);
+        const __m512i bytes = _mm512_loadu_si512(reinterpret_cast<const void*>(in + i));
+        starts = nextStarts;
+
+        if (block.keep == ~uint64_t{0} && block.triplets == 0) {
+            _mm512_storeu_si512(reinterpret_cast<void*>(out), bytes);
+            out += DECODE_BLOCK_BYTES;
+            continue;
+        }
+
+        __m512i trits[BASE] = {finalTrits512(in + i + 2), finalTrits512(in + i + 5), finalTrits512(in + i + 8)};
+        if (key) {
+            for (int g = 0; g < BASE; g++) {
+                const __m512i negated = _mm512_maskz_expand_epi8(
+                    block.triplets,
+                    _mm512_loadu_si512(reinterpret_cast<const void*>(negatedKeyTrits(key, keyLength, g) + keyIndex)));
+                trits[g] = _mm512_shuffle_epi8(mod3, _mm512_add_epi8(trits[g], negated));
+            }
+            keyIndex += static_cast<size_t>(_mm_popcnt_u64(block.triplets));
+            if (keyIndex >= keyLength) keyIndex %= keyLength;
+        }
+
+        // The store is cut to the exact length: the parallel decoder runs chunks into adjacent output.
+        const __m512i letters =
+            _mm512_add_epi8(joinTrits512(trits[0], trits[1], trits[2]), _mm512_set1_epi8('A' - 1));
+        const unsigned written = static_cast<unsigned>(_mm_popcnt_u64(block.keep));
+        _mm512_mask_storeu_epi8(out, _bzhi_u64(~uint64_t{0}, written),
+                                _mm512_maskz_compress_epi8(block.keep, _mm512_mask_blend_epi8(block.triplets, bytes, letters)));
+        out += written;
+    }
+
+    i += glyphSpill(carry);
+
+    if (key) {
+        out += decodeKeyed(in + i, length - i, key, keyLength, keyIndex, out);
+    } else {
+        out += decodeStandard(in + i, length - i, out);
+    }
+
+    return static_cast<size_t>(out - start);
+}
+
+/**
+ * @brief AVX-512 VBMI Standard Mode decoder (see decodeAVX512()).
+ *
+ * @param in The ciphertext bytes.
+ * @param length The number of ciphertext bytes.
+ * @param out The destination; must hold `length` bytes.
+ * @return size_t The number of bytes written.
+ */
+size_t decodeStandardAVX512(const unsigned char* in, size_t length, unsigned char* out) {
+    return decodeAVX512(in, length, nullptr, 0, 0, out);
+}
+
+/**
+ * @brief AVX-512 VBMI Delta Mode decoder (see decodeAVX512()).
+ *
+ * @param in The ciphertext bytes.
+ * @param length The number of ciphertext bytes.
+ * @param key The key's trit codes, repeated past keyLength (see DeltaKey::codes()).
+ * @param keyLength The number of key codes; must be non-zero.
+ * @param keyIndex The key position of the first triplet in `in` (less than keyLength).
+ * @param out The destination; must hold `length` bytes.
+ * @return size_t The number of bytes written.
+ */
+size_t decodeKeyedAVX512(const unsigned char* in, size_t length, const unsigned char* key, size_t keyLength,
+                         size_t keyIndex, unsigned char* out) {
+    return decodeAVX512(in, length, key, keyLength, keyIndex, out);
+}
+
+#else
+
+size_t encodeStandardAVX512(const unsigned char* in, size_t length, unsigned char* out) {
+    return encodeStandard(in, length, out);
+}
+
+size_t encodeKeyedAVX512(const unsigned char* in, size_t length, const unsigned char* key, size_t keyLength,
+                         size_t keyIndex, unsigned char* out) {
+    return encodeKeyed(in, length, key, keyLength, keyIndex, out);
+}
+
+size_t decodeStandardAVX512(const unsigned char* in, size_t length, unsigned char* out) {
+    return decodeStandard(in, length, out);
+}
+
+size_t decodeKeyedAVX512(const unsigned char* in, size_t length, const unsigned char* key, size_t keyLength,
+                         size_t keyIndex, unsigned char* out) {
+    return decodeKeyed(in, length, key, keyLength, keyIndex, out);
+}
+
+#endif
@@ -0,0 +1,597 @@
+#include "Delta_K_AsyncIO.hpp"
+#include "Delta_K_Stream.hpp"
+#include "Delta_K_Tables.hpp"
+
+#include <cstdint>
+#include <iostream>
+#include <vector>
+
+#if defined(__unix__) || defined(__APPLE__)
+#define DELTA_K_POSIX_IO
+#include <fcntl.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <cerrno>
+#include <cstring>
+#endif
+
+#if defined(__linux__) && defined(__has_include)
+#if __has_include(<linux/io_uring.h>)
+#define DELTA_K_URING
+#include <linux/io_uring.h>
+#include <sys/mman.h>
+#include <sys/syscall.h>
+#endif
+#endif
+
+#ifdef DELTA_K_POSIX_IO
+
+/**
+ * @brief The most bytes one io_uring request moves; longer requests finish in parts.
+ */
+constexpr size_t MAX_TRANSFER = size_t{1} << 30;
+
+/**
+ * @brief How many times submit() asks the kernel again to take a request it turned away
+ * for a transient reason (EAGAIN, EBUSY, or nothing consumed) before giving up on it.
+ */
+constexpr int SUBMIT_RETRIES = 64;
+
+/**
+ * @brief One read or write on its way to the disk.
+ * A partial transfer moves `data` and `offset` forward and is submitted again for the
+ * rest, so `inFlight` only clears once all `length` bytes have been moved.
+ */
+struct IoRequest {
+    bool write = false;
+    int fd = -1;
+    char* data = nullptr;
+    size_t length = 0;
+    off_t offset = 0;
+    bool inFlight = false;
+};
+
+/**
+ * @brief A submission/completion queue for IoRequests.
+ *
+ * With io_uring, requests are queued in the kernel's submission ring and completions are
+ * reaped from its completion ring, through the raw system calls (no liburing needed).
+ * Without it, submit() runs the pread() or pwrite() on the spot, synchronously on the
+ * caller's thread, and wait() hands the finished requests back in order. The pipeline
+ * code is the same for both, but the fallback has no overlap at all: each transfer
+ * finishes before the pipeline codes the next block.
+ */
+class IoRing {
+public:
+    ~IoRing();
+
+    bool open(unsigned entries, IoBackend backend);
+    bool submit(IoRequest* request);
+    IoRequest* wait(long& result);
+
+private:
+    void closeRing();
+
+    int ringFd = -1;
+    void* ringMemory = nullptr;
+    size_t ringSize = 0;
+    void* sqeMemory = nullptr;
+    size_t sqeSize = 0;
+
+    unsigned* sqHead = nullptr;
+    unsigned* sqTail = nullptr;
+    unsigned sqMask = 0;
+    unsigned* sqArray = nullptr;
+    unsigned* cqHead = nullptr;
+    unsigned* cqTail = nullptr;
+    unsigned cqMask = 0;
+    char* cqEntries = nullptr;
+
+    std::vector<IoRequest*> finished;
+    std::vector<long> results;
+    size_t nextFinished = 0;
+};
+
+#ifdef DELTA_K_URING
+
+static int uringSetup(unsigned entries, io_uring_params* params) {
+    return static_cast<int>(syscall(__NR_io_uring_setup, entries, params));
+}
+
+static int uringEnter(int fd, unsigned toSubmit, unsigned minComplete, unsigned flags) {
+    return static_cast<int>(syscall(__NR_io_uring_enter, fd, toSubmit, minComplete, flags, nullptr, 0));
+}
+
+#endif
+
+IoRing::~IoRing() {
+    closeRing();
+}
+
+/**
+ * @brief Releases the io_uring instance and its mappings, if there are any.
+ */
+void IoRing::closeRing() {
+#ifdef DELTA_K_URING
+    if (sqeMemory) munmap(sqeMemory, sqeSize);
+    if (ringMemory) munmap(ringMemory, ringSize);
+    if (ringFd >= 0) close(ringFd);
+#endif
+    ringFd = -1;
+    ringMemory = nullptr;
+    sqeMemory = nullptr;
+}
+
+/**
+ * @brief Sets up the queue. An io_uring that the kernel refuses (too old, or blocked by a
+ * sandbox) quietly falls back to pread()/pwrite().
+ *
+ * @param entries The most requests in flight at once.
+ * @param backend The backend to try.
+ * @return true If io_uring is in use.
+ */
+bool IoRing::open(unsigned entries, IoBackend backend) {
+    finished.reserve(entries);
+    results.reserve(entries);
+
+#ifdef DELTA_K_URING
+    if (backend != IoBackend::Uring) return false;
+
+    io_uring_params params;
+    std::memset(&params, 0, sizeof(params));
+
+    ringFd = uringSetup(entries, &params);
+    if (ringFd < 0) return false;
+
+    // One mapping holds both rings; kernels without IORING_FEAT_SINGLE_MMAP are not worth
+    // a second code path and use the fallback.
+    const size_t sqSize = params.sq_off.array + (params.sq_entries * sizeof(unsigned));
+    const size_t cqSize = params.cq_off.cqes + (params.cq_entries * sizeof(io_uring_cqe));
+    ringSize = sqSize > cqSize ? sqSize : cqSize;
+    sqeSize = params.sq_entries * sizeof(io_uring_sqe);
+
+    if (params.features & IORING_FEAT_SINGLE_MMAP) {
+        void* ring = mmap(nullptr, ringSize, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, ringFd,
+                          IORING_OFF_SQ_RING);
+        void* sqes = mmap(nullptr, sqeSize, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, ringFd,
+                          IORING_OFF_SQES);
+        if (ring != MAP_FAILED) ringMemory = ring;
+        if (sqes != MAP_FAILED) sqeMemory = sqes;
+    }
+
+    if (!ringMemory || !sqeMemory) {
+        closeRing();
+        return false;
+    }
+
+    char* ring = static_cast<char*>(ringMemory);
+    sqHead = reinterpret_cast<unsigned*>(ring + params.sq_off.head);
+    sqTail = reinterpret_cast<unsigned*>(ring + params.sq_off.tail);
+    sqMask = *reinterpret_cast<unsigned*>(ring + params.sq_off.ring_mask);
+    sqArray = reinterpret_cast<unsigned*>(ring + params.sq_off.array);
+    cqHead = reinterpret_cast<unsigned*>(ring + params.cq_off.head);
+    cqTail = reinterpret_cast<unsigned*>(ring + params.cq_off.tail);
+    cqMask = *reinterpret_cast<unsigned*>(ring + params.cq_off.ring_mask);
+    cqEntries = ring + params.cq_off.cqes;
+
+    return true;
+#else
+    (void)backend;
+    return false;
+#endif
+}
+
+/**
+ * @brief Starts a request (or, without io_uring, runs it synchronously).
+ *
+ * The queue entry is published, then io_uring_enter() is asked to consume it, again
+ * after an interruption or a transient refusal. Without SQPOLL the kernel only reads
+ * the ring inside io_uring_enter(), so an entry it never consumed is withdrawn again
+ * before failing: nothing then refers to the request, and it is no longer in flight.
+ *
+ * @return true If it was submitted; false with errno set otherwise.
+ */
+bool IoRing::submit(IoRequest* request) {
+    request->inFlight = true;
+
+#ifdef DELTA_K_URING
+    if (ringFd >= 0) {
+        const unsigned tail = *sqTail;
+        const unsigned index = tail & sqMask;
+        io_uring_sqe* sqe = static_cast<io_uring_sqe*>(sqeMemory) + index;
+
+        std::memset(sqe, 0, sizeof(*sqe));
+        sqe->opcode = request->write ? IORING_OP_WRITE : IORING_OP_READ;
+        sqe->fd = request->fd;
+        sqe->addr = reinterpret_cast<unsigned long long>(request->data);
+        sqe->len = static_cast<unsigned>(request->length < MAX_TRANSFER ? request->length : MAX_TRANSFER);
+        sqe->off = static_cast<unsigned long long>(request->offset);
+        sqe->user_data = reinterpret_cast<unsigned long long>(request);
+
+        sqArray[index] = index;
+        __atomic_store_n(sqTail, tail + 1, __ATOMIC_RELEASE);
+
+        int error = EAGAIN;
+        for (int attempt = 0; attempt < SUBMIT_RETRIES;) {
+            const int submitted = uringEnter(ringFd, 1, 0, 0);
+            if (submitted == 1) return true;
+            if (submitted < 0) {
+                error = errno;
+                if (error == EINTR) continue;
+                if (error != EAGAIN && error != EBUSY) break;
+            }
+            attempt++;
+        }
+
+        if (__atomic_load_n(sqHead, __ATOMIC_ACQUIRE) != tail) return true;
+
+        __atomic_store_n(sqTail, tail, __ATOMIC_RELEASE);
+        request->inFlight = false;
+        errno = error;
+        return false;
+    }
+#endif
+
+    const ssize_t done = request->write ? pwrite(request->fd, request->data, request->length, request->offset)
+                                        : pread(request->fd, request->data, request->length, request->offset);
+
+    finished.push_back(request);
+    results.push_back(done < 0 ? -errno : static_cast<long>(done));
+    return true;
+}
+
+/**
+ * @brief Waits for the next request to finish.
+ *
+ * @param result Receives the bytes moved, or a negated errno value.
+ * @return IoRequest* The finished request, or null if waiting failed (errno is set).
+ */
+IoRequest* IoRing::wait(long& result) {
+#ifdef DELTA_K_URING
+    if (ringFd >= 0) {
+        unsigned head = *cqHead;
+
+        while (head == __atomic_load_n(cqTail, __ATOMIC_ACQUIRE)) {
+            if (uringEnter(ringFd, 0, 1, IORING_ENTER_GETEVENTS) < 0 && errno != EINTR) return nullptr;
+        }
+
+        const io_uring_cqe* cqe = reinterpret_cast<const io_uring_cqe*>(cqEntries) + (head & cqMask);
+        IoRequest* request = reinterpret_cast<IoRequest*>(static_cast<uintptr_t>(cqe->user_data));
+        result = cqe->res;
+        __atomic_store_n(cqHead, head + 1, __ATOMIC_RELEASE);
+
+        return request;
+    }
+#endif
+
+    if (nextFinished == finished.size()) {
+        errno = EINVAL;
+        return nullptr;
+    }
+
+    IoRequest* request = finished[nextFinished];
+    result = results[nextFinished];
+    if (++nextFinished == finished.size()) {
+        finished.clear();
+        results.clear();
+        nextFinished = 0;
+    }
+
+    return request;
+}
+
+/**
+ * @brief One block of the pipeline: its buffers, and the transfers that fill and drain them.
+ */
+struct PipelineSlot {
+    std::vector<char> input;
+    std::vector<char> output;
+    size_t inputLength = 0;
+    IoRequest read;
+    IoRequest write;
+};
+
+/**
+ * @brief Waits for one transfer to finish and books it; a partial transfer is submitted
+ * again for the rest.
+ *
+ * @return true Unless the transfer failed or made no progress (errno is set).
+ */
+static bool completeOne(IoRing& ring) {
+    long result = 0;
+    IoRequest* request = ring.wait(result);
+
+    if (!request) return false;
+    if (result <= 0) {
+        request->inFlight = false;
+        errno = result < 0 ? static_cast<int>(-result) : EIO;
+        return false;
+    }
+
+    request->data += result;
+    request->length -= static_cast<size_t>(result);
+    request->offset += result;
+    if (request->length == 0) {
+        request->inFlight = false;
+        return true;
+    }
+
+    return ring.submit(request);
+}
+
+/**
+ * @brief Waits until one transfer has moved all its bytes, booking others as they finish.
+ */
+static bool waitFor(IoRing& ring, const IoRequest& request) {
+    while (request.inFlight) {
+        if (!completeOne(ring)) return false;
+    }
+
+    return true;
+}
+
+/**
+ * @brief Waits out every transfer still in flight, after a failure, so no buffer is freed
+ * while the kernel may still use it.
+ */
+static void drainSlots(IoRing& ring, std::vector<PipelineSlot>& slots) {
+    for (PipelineSlot& slot : slots) {
+        for (IoRequest* request : {&slot.read, &slot.write}) {
+            long result;
+            while (request->inFlight) {
+                IoRequest* done = ring.wait(result);
+                if (!done) return;
+                done->inFlight = false;
+            }
+        }
+    }
+}
+
+/**
+ * @brief Starts a transfer of a whole buffer at a file offset.
+ */
+static bool startTransfer(IoRing& ring, IoRequest& request, bool write, int fd, char* data, size_t length,
+                          off_t offset) {
+    request.write = write;
+    request.fd = fd;
+    request.data = data;
+    request.length = length;
+    request.offset = offset;
+
+    return ring.submit(&request);
+}
+
+/**
+ * @brief Runs a file through an encoder or decoder, with reads, coding and writes overlapped.
+ *
+ * Block b lives in slot b % depth. Reads for the first `depth` blocks start at once;
+ * each block is then coded as soon as its read lands and its slot's previous write has
+ * drained, its write is queued, and the slot's read for block b + depth is started.
+ * So while one block is coded, up to depth - 1 reads and depth writes are in flight.
+ * The codec carries the key position and any cut-off triplet across blocks.
+ */
+template <typename Codec>
+static bool runPipeline(IoRing& ring, Codec& codec, int inputFd, size_t inputLength, int outputFd,
+                        size_t outputBlock, const AsyncOptions& options) {
+    const size_t depth = options.depth;
+    const size_t blockSize = options.blockSize;
+    const size_t blocks = (inputLength + blockSize - 1) / blockSize;
+    std::vector<PipelineSlot> slots(depth);
+    off_t outputOffset = 0;
+
+    for (PipelineSlot& slot : slots) {
+        slot.input.resize(blockSize);
+        slot.output.resize(outputBlock);
+    }
+
+    auto startRead = [&](size_t block) {
+        PipelineSlot& slot = slots[block % depth];
+        const size_t start = block * blockSize;
+
+        slot.inputLength = inputLength - start < blockSize ? inputLength - start : blockSize;
+        return startTransfer(ring, slot.read, false, inputFd, slot.input.data(), slot.inputLength,
+                             static_cast<off_t>(start));
+    };
+
+    auto startWrite = [&](PipelineSlot& slot, size_t length) {
+        if (length == 0) return true;
+
+        const off_t offset = outputOffset;
+        outputOffset += static_cast<off_t>(length);
+        return startTransfer(ring, slot.write, true, outputFd, slot.output.data(), length, offset);
+    };
+
+    bool ok = true;
+    for (size_t b = 0; ok && b < blocks && b < depth; b++) {
+        ok = startRead(b);
+    }
+
+    for (size_t b = 0; ok && b < blocks; b++) {
+        PipelineSlot& slot = slots[b % depth];
+
+        ok = waitFor(ring, slot.read) && waitFor(ring, slot.write);
+        if (!ok) break;
+
+        const size_t written = codec.feed({slot.input.data(), slot.inputLength}, slot.output.data());
+        ok = startWrite(slot, written) && (b + depth >= blocks || startRead(b + depth));
+    }
+
+    if (ok) {
+        PipelineSlot& slot = slots[blocks % depth];
+        ok = waitFor(ring, slot.write) && startWrite(slot, codec.finish(slot.output.data()));
+    }
+
+    for (size_t s = 0; ok && s < depth; s++) {
+        ok = waitFor(ring, slots[s].write);
+    }
+
+    if (!ok) {
+        const int error = errno;
+        drainSlots(ring, slots);
+        errno = error;
+    }
+
+    return ok;
+}
+
+/**
+ * @brief Writes a whole buffer to a descriptor, however many write() calls it takes.
+ */
+static bool writeAll(int fd, const char* data, size_t length) {
+    while (length > 0) {
+        const ssize_t done = write(fd, data, length);
+        if (done < 0 && errno == EINTR) continue;
+        if (done <= 0) return false;
+        data += done;
+        length -= static_cast<size_t>(done);
+    }
+
+    return true;
+}
+
+/**
+ * @brief Runs a pipe, FIFO or device through an encoder or decoder with plain read() and
+ * write() calls. Such files have no size and no offsets to pread() at, so they cannot
+ * take the block pipeline.
+ */
+template <typename Codec>
+static bool runSequential(Codec& codec, int inputFd, int outputFd, size_t outputBlock, size_t blockSize) {
+    std::vector<char> input(blockSize);
+    std::vector<char> output(outputBlock);
+
+    for (;;) {
+        const ssize_t length = read(inputFd, input.data(), blockSize);
+        if (length < 0 && errno == EINTR) continue;
+        if (length < 0) return false;
+        if (length == 0) break;
+
+        const size_t written = codec.feed({input.data(), static_cast<size_t>(length)}, output.data());
+        if (!writeAll(outputFd, output.data(), written)) return false;
+    }
+
+    return writeAll(outputFd, output.data(), codec.finish(output.data()));
+}
+
+/**
+ * @brief Shared asynchronous file codec for both directions (see runPipeline()).
+ * Inputs or outputs that are not regular files (pipes, FIFOs, devices) are streamed
+ * sequentially instead (see runSequential()), since their st_size and offsets mean
+ * nothing.
+ */
+static bool codeFileAsync(bool encrypting, const std::string& inputPath, const std::string& outputPath,
+                          const std::string& key, const AsyncOptions& options) {
+    struct stat inputInfo;
+    struct stat outputInfo;
+
+    const int inputFd = ::open(inputPath.c_str(), O_RDONLY);
+    if (inputFd < 0 || fstat(inputFd, &inputInfo) != 0) {
+        std::cerr << "Cannot open input file " << inputPath << ": " << std::strerror(errno) << std::endl;
+        if (inputFd >= 0) close(inputFd);
+        return false;
+    }
+
+    // Truncating the output first would destroy the input if both are the same file.
+    if (stat(outputPath.c_str(), &outputInfo) == 0 && outputInfo.st_dev == inputInfo.st_dev &&
+        outputInfo.st_ino == inputInfo.st_ino) {
+        std::cerr << "Input and output are the same file: " << outputPath << std::endl;
+        close(inputFd);
+        return false;
+    }
+
+    const int outputFd = ::open(outputPath.c_str(), O_WRONLY | O_CREAT | O_TRUNC, 0644);
+    if (outputFd < 0) {
+        std::cerr << "Cannot open output file " << outputPath << ": " << std::strerror(errno) << std::endl;
+        close(inputFd);
+        return false;
+    }
+
+    const size_t inputLength = static_cast<size_t>(inputInfo.st_size);
+    const bool sequential = !S_ISREG(inputInfo.st_mode) || fstat(outputFd, &outputInfo) != 0 ||
+                            !S_ISREG(outputInfo.st_mode);
+    AsyncOptions shape = options;
+    IoRing ring;
+    bool ok;
+
+    if (shape.depth == 0) shape.depth = 1;
+    if (shape.blockSize == 0) shape.blockSize = AsyncOptions().blockSize;
+
+    const size_t outputBlock = encrypting ? shape.blockSize * TRIPLET_SIZE : shape.blockSize + TRIPLET_SIZE;
+    // Every slot can have a read and a write in flight.
+    if (!sequential) ring.open(shape.depth * 2, shape.backend);
+
+    if (encrypting) {
+        DeltaKEncoder encoder(key);
+        ok = sequential ? runSequential(encoder, inputFd, outputFd, outputBlock, shape.blockSize)
+                        : runPipeline(ring, encoder, inputFd, inputLength, outputFd, outputBlock, shape);
+    } else {
+        DeltaKDecoder decoder(key);
+        ok = sequential ? runSequential(decoder, inputFd, outputFd, outputBlock, shape.blockSize)
+                        : runPipeline(ring, decoder, inputFd, inputLength, outputFd, outputBlock, shape);
+    }
+
+    if (!ok) {
+        std::cerr << (encrypting ? "Encryption" : "Decryption") << " failed: " << std::strerror(errno) << std::endl;
+    }
+
+    close(inputFd);
+    if (close(outputFd) != 0 && ok) {
+        std::cerr << "Cannot write " << outputPath << ": " << std::strerror(errno) << std::endl;
+        ok = false;
+    }
+
+    return ok;
+}
+
+/**
+ * @brief Checks whether the kernel lets this process set up an io_uring.
+ *
+ * @return true If IoBackend::Uring will really use io_uring.
+ */
+bool uringAvailable() {
+    IoRing ring;
+    return ring.open(1, IoBackend::Uring);
+}
+
+#else
+
+bool uringAvailable() {
+    return false;
+}
+
+static bool codeFileAsync(bool, const std::string&, const std::string&, const std::string&, const AsyncOptions&) {
+    std::cerr << "Asynchronous file I/O is not available on this platform" << std::endl;
+    return false;
+}
+
+#endif
+
+/**
+ * @brief Encrypts a file into another with overlapped reads, encoding and writes.
+ * Standard Mode for an empty key, Delta Mode otherwise.
+ *
+ * @param inputPath The plaintext file.
+ * @param outputPath The ciphertext file; created or truncated, and never the input.
+ * @param key The keyword, or an empty string for Standard Mode.
+ * @param options The backend, the number of blocks in flight and the block size.
+ * @return true If the output was written; otherwise the reason is printed to stderr.
+ */
+bool encryptFileAsync(const std::string& inputPath, const std::string& outputPath, const std::string& key,
+                      const AsyncOptions& options) {
+    return codeFileAsync(true, inputPath, outputPath, key, options);
+}
+
+/**
+ * @brief Decrypts a file into another with overlapped reads, decoding and writes.
+ * Standard Mode for an empty key, Delta Mode otherwise.
+ *
+ * @param inputPath The ciphertext file.
+ * @param outputPath The plaintext file; created or truncated, and never the input.
+ * @param key The keyword the ciphertext was encrypted with, or an empty string.
+ * @param options The backend, the number of blocks in flight and the block size.
+ * @return true If the output was written; otherwise the reason is printed to stderr.
+ */
+bool decryptFileAsync(const std::string& inputPath, const std::string& outputPath, const std::string& key,
+                      const AsyncOptions& options) {
+    return codeFileAsync(false, inputPath, outputPath, key, options);
+}
@@ -0,0 +1,154 @@
+#include "Delta_K_Codec.hpp"
+#include "Delta_K_Dispatch.hpp"
+#include "Delta_K_Engine.hpp"
+#include "Delta_K_Tables.hpp"
+
+#include <algorithm>
+
+/**
+ * @brief The smallest output buffer the codec keeps.
+ */
+constexpr size_t MIN_CAPACITY = 4096;
+
+/**
+ * @brief A message counts as small when it needs less than 1/SHRINK_RATIO of the buffer.
+ */
+constexpr size_t SHRINK_RATIO = 4;
+
+/**
+ * @brief The number of small messages in a row after which the buffer shrinks.
+ */
+constexpr size_t SHRINK_AFTER = 256;
+
+/**
+ * @brief Creates a codec with an empty buffer and an empty key cache.
+ *
+ * @param keySlots The number of compiled keys to keep (at least 1).
+ */
+DeltaKCodec::DeltaKCodec(size_t keySlots) : keySlots(std::max<size_t>(keySlots, 1)) {
+    keys.reserve(this->keySlots);
+}
+
+/**
+ * @brief Encrypts a message (see encrypt()): Standard Mode for an empty key, Delta Mode
+ * otherwise.
+ *
+ * @param plaintext The source text.
+ * @param key The keyword; the caller validates it (see keyValidation()).
+ * @return std::string_view The ciphertext, valid until the next call on this codec.
+ */
+std::string_view DeltaKCodec::encrypt(std::string_view plaintext, std::string_view key) {
+    const unsigned char* in = reinterpret_cast<const unsigned char*>(plaintext.data());
+    const KernelSet& kernels = activeKernels();
+    const size_t length = plaintext.length() + (kernels.countLetters(in, plaintext.length()) * (TRIPLET_SIZE - 1));
+    unsigned char* out = reserve(length);
+
+    if (key.empty()) {
+        kernels.encodeStandard(in, plaintext.length(), out);
+    } else {
+        const CompiledKey& compiled = compile(key);
+        kernels.encodeKeyed(in, plaintext.length(), compiled.key.codes(), compiled.key.length(), 0, out);
+    }
+
+    return {reinterpret_cast<const char*>(out), length};
+}
+
+/**
+ * @brief Decrypts a message (see decrypt()): Standard Mode for an empty key, Delta Mode
+ * otherwise.
+ *
+ * @param ciphertext The glyph text.
+ * @param key The keyword the ciphertext was encrypted with, or empty.
+ * @return std::string_view The plaintext, valid until the next call on this codec.
+ */
+std::string_view DeltaKCodec::decrypt(std::string_view ciphertext, std::string_view key) {
+    const unsigned char* in = reinterpret_cast<const unsigned char*>(ciphertext.data());
+    const KernelSet& kernels = activeKernels();
+    unsigned char* out = reserve(ciphertext.length());
+    size_t written;
+
+    if (key.empty()) {
+        written = kernels.decodeStandard(in, ciphertext.length(), out);
+    } else {
+        const CompiledKey& compiled = compile(key);
+        written = kernels.decodeKeyed(in, ciphertext.length(), compiled.key.codes(), compiled.key.length(), 0, out);
+    }
+
+    return {reinterpret_cast<const char*>(out), written};
+}
+
+/**
+ * @brief Frees the output buffer and forgets the compiled keys.
+ */
+void DeltaKCodec::release() {
+    output.reset();
+    outputCapacity = 0;
+    smallCalls = 0;
+    smallPeak = 0;
+    keys.clear();
+}
+
+/**
+ * @brief Returns a compiled key (see DeltaKey), compiling it on a cache miss.
+ *
+ * The cache is a handful of slots searched in order, which beats hashing the key at
+ * this size. A miss overwrites the least recently used slot in place, so once the
+ * slots have held keys as long as the new one it allocates nothing.
+ */
+const DeltaKCodec::CompiledKey& DeltaKCodec::compile(std::string_view key) {
+    CompiledKey* victim = nullptr;
+    clock++;
+
+    for (CompiledKey& entry : keys) {
+        if (entry.text == key) {
+            entry.lastUse = clock;
+            return entry;
+        }
+        if (!victim || entry.lastUse < victim->lastUse) victim = &entry;
+    }
+
+    // keys was reserved up front, so the slots never move.
+    if (keys.size() < keySlots) {
+        keys.emplace_back();
+        victim = &keys.back();
+    }
+
+    victim->text.assign(key.data(), key.length());
+    victim->key.assign(key);
+    victim->lastUse = clock;
+
+    return *victim;
+}
+
+/**
+ * @brief Returns an output buffer of at least `length` bytes.
+ *
+ * The buffer grows by at least half its size, and shrinks only after SHRINK_AFTER
+ * messages in a row have used less than a quarter of it, down to twice the largest of
+ * them. Its contents are not kept: every message overwrites it.
+ */
+unsigned char* DeltaKCodec::reserve(size_t length) {
+    if (length > outputCapacity) {
+        outputCapacity = std::max({length, outputCapacity + (outputCapacity / 2), MIN_CAPACITY});
+        output.reset(new unsigned char[outputCapacity]);
+        smallCalls = 0;
+        smallPeak = 0;
+    } else if (length < outputCapacity / SHRINK_RATIO) {
+        smallPeak = std::max(smallPeak, length);
+
+        if (++smallCalls == SHRINK_AFTER) {
+            const size_t shrunk = std::max(smallPeak * 2, MIN_CAPACITY);
+            if (shrunk < outputCapacity) {
+                outputCapacity = shrunk;
+                output.reset(new unsigned char[outputCapacity]);
+            }
+            smallCalls = 0;
+            smallPeak = 0;
+        }
+    } else {
+        smallCalls = 0;
+        smallPeak = 0;
+    }
+
+    return output.get();
+}
@@ -0,0 +1,146 @@
+#include "Delta_K_Dispatch.hpp"
+#include "Delta_K_Engine.hpp"
+#include "Delta_K_Kernels.hpp"
+
+#include <cstdlib>
+#include <iostream>
+
+/**
+ * @brief The tier names accepted by parseTier() and the DELTA_K_TIER variable, by tier.
+ */
+static const char* const TIER_NAMES[] = {"scalar", "swar", "sse4.2", "avx2", "avx512"};
+
+/**
+ * @brief Returns the name of a tier, as accepted by parseTier().
+ */
+const char* tierName(KernelTier tier) {
+    return TIER_NAMES[static_cast<int>(tier)];
+}
+
+/**
+ * @brief Reads a tier from its name: scalar, swar, sse4.2 (or sse42), avx2 or avx512.
+ *
+ * @param name The tier name, in lowercase.
+ * @param tier Receives the tier if the name is known.
+ * @return true If the name is a known tier.
+ */
+bool parseTier(const std::string& name, KernelTier& tier) {
+    for (int t = 0; t <= static_cast<int>(KernelTier::AVX512); t++) {
+        if (name == TIER_NAMES[t]) {
+            tier = static_cast<KernelTier>(t);
+            return true;
+        }
+    }
+
+    if (name == "sse42") {
+        tier = KernelTier::SSE42;
+        return true;
+    }
+
+    return false;
+}
+
+/**
+ * @brief Checks whether this host can run a tier's kernels.
+ * The scalar and SWAR tiers are plain C++ and run everywhere.
+ */
+bool tierSupported(KernelTier tier) {
+    switch (tier) {
+        case KernelTier::AVX512:
+            return cpuHasAVX512VBMI2();
+        case KernelTier::AVX2:
+            return cpuHasAVX2();
+        case KernelTier::SSE42:
+            return cpuHasSSE42();
+        default:
+            return true;
+    }
+}
+
+/**
+ * @brief Returns the fastest tier this host supports.
+ * Each tier's kernels outrun the tier below it in every function (see delta-k-bench),
+ * so the highest supported tier is bound whole.
+ */
+KernelTier bestTier() {
+    for (int t = static_cast<int>(KernelTier::AVX512); t > static_cast<int>(KernelTier::SWAR); t--) {
+        if (tierSupported(static_cast<KernelTier>(t))) return static_cast<KernelTier>(t);
+    }
+
+    return KernelTier::SWAR;
+}
+
+/**
+ * @brief Returns the functions bound for a tier.
+ * The AVX-512 tier counts letters with the AVX2 counter.
+ *
+ * @param tier The tier; the caller must check tierSupported() first.
+ */
+KernelSet kernelsFor(KernelTier tier) {
+    switch (tier) {
+        case KernelTier::AVX512:
+            return {tier, countLettersAVX2, encodeStandardAVX512, encodeKeyedAVX512, decodeStandardAVX512,
+                    decodeKeyedAVX512};
+        case KernelTier::AVX2:
+            return {tier, countLettersAVX2, encodeStandardAVX2, encodeKeyedAVX2, decodeStandardAVX2, decodeKeyedAVX2};
+        case KernelTier::SSE42:
+            return {tier, countLettersSSE42, encodeStandardSSE42, encodeKeyedSSE42, decodeStandardSSE42,
+                    decodeKeyedSSE42};
+        case KernelTier::SWAR:
+            return {tier, countLettersSWAR, encodeStandardSWAR, encodeKeyedSWAR, decodeStandardSWAR, decodeKeyedSWAR};
+        default:
+            return {KernelTier::Scalar, countLetters, encodeStandard, encodeKeyed, decodeStandard, decodeKeyed};
+    }
+}
+
+/**
+ * @brief Picks the startup tier: DELTA_K_TIER if it names a supported tier, otherwise
+ * the best one. A bad DELTA_K_TIER value is reported and ignored.
+ */
+static KernelSet initialKernels() {
+    const char* forced = std::getenv(TIER_ENVIRONMENT);
+    KernelTier tier;
+
+    if (forced && *forced) {
+        if (!parseTier(forced, tier)) {
+            std::cerr << TIER_ENVIRONMENT << ": unknown tier '" << forced << "', using " << tierName(bestTier())
+                      << std::endl;
+        } else if (!tierSupported(tier)) {
+            std::cerr << TIER_ENVIRONMENT << ": tier '" << forced << "' is not supported on this CPU, using "
+                      << tierName(bestTier()) << std::endl;
+        } else {
+            return kernelsFor(tier);
+        }
+    }
+
+    return kernelsFor(bestTier());
+}
+
+/**
+ * @brief The bound kernels, probed once on first use.
+ */
+static KernelSet& boundKernels() {
+    static KernelSet kernels = initialKernels();
+    return kernels;
+}
+
+/**
+ * @brief Returns the kernels encrypt() and decrypt() run on.
+ */
+const KernelSet& activeKernels() {
+    return boundKernels();
+}
+
+/**
+ * @brief Forces a tier, e.g. for benchmarking or to isolate a kernel bug.
+ * Call it before encoding or decoding starts on other threads.
+ *
+ * @param tier The tier to bind.
+ * @return true If the tier was bound; false if this host cannot run it.
+ */
+bool selectTier(KernelTier tier) {
+    if (!tierSupported(tier)) return false;
+
+    boundKernels() = kernelsFor(tier);
+    return true;
+}
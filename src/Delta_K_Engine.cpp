@@ -0,0 +1,240 @@
+#include "Delta_K_Engine.hpp"
+#include "Delta_K_Tables.hpp"
+
+#include <cstring>
+
+/**
+ * @brief Counts the alphabetic bytes in a buffer.
+ *
+ * @param in The source bytes.
+ * @param length The number of source bytes.
+ * @return size_t The number of letters (A-Z, a-z).
+ */
+size_t countLetters(const unsigned char* in, size_t length) {
+    size_t letters = 0;
+
+    for (size_t i = 0; i < length; i++) {
+        letters += isLetterByte(in[i]);
+    }
+
+    return letters;
+}
+
+/**
+ * @brief Computes the exact Standard Mode (and Delta Mode) ciphertext length for a buffer.
+ * Every letter grows from 1 byte to a 9-byte glyph triplet; every other byte is copied.
+ *
+ * @param in The source bytes.
+ * @param length The number of source bytes.
+ * @return size_t The number of bytes encodeStandard() will write.
+ */
+size_t standardEncodedSize(const unsigned char* in, size_t length) {
+    return length + (countLetters(in, length) * (TRIPLET_SIZE - 1));
+}
+
+/**
+ * @brief Table-driven Standard Mode encoder.
+ *
+ * Each source byte is looked up in STANDARD_TABLE and its finished output is copied
+ * into the buffer. Since every source byte produces at least one output byte, there is
+ * always room for a full ENTRY_WIDTH store while ENTRY_WIDTH source bytes remain, so the
+ * bulk of the input is written with fixed-width stores and only the tail copies exactly.
+ *
+ * @param in The source bytes.
+ * @param length The number of source bytes.
+ * @param out The destination; must hold standardEncodedSize(in, length) bytes.
+ * @return size_t The number of bytes written.
+ */
+size_t encodeStandard(const unsigned char* in, size_t length, unsigned char* out) {
+    unsigned char* start = out;
+    size_t i = 0;
+
+    for (; i + ENTRY_WIDTH <= length; i++) {
+        const GlyphEntry& entry = STANDARD_TABLE[in[i]];
+        std::memcpy(out, &entry, ENTRY_WIDTH);
+        out += entry.length;
+    }
+
+    for (; i < length; i++) {
+        const GlyphEntry& entry = STANDARD_TABLE[in[i]];
+        std::memcpy(out, entry.bytes, entry.length);
+        out += entry.length;
+    }
+
+    return static_cast<size_t>(out - start);
+}
+
+/**
+ * @brief Table-driven Delta Mode encoder.
+ *
+ * Every byte costs one lookup into KEYED_BYTE_TABLE (the finished triplet for this
+ * plaintext/key pair, or the byte itself) and one fixed-width store. The key position
+ * is a wrapping counter that only advances on letters, matching encrypt(plaintext, key);
+ * it wraps with a select rather than a branch, since where it wraps in mixed text is
+ * unpredictable.
+ *
+ * @param in The source bytes.
+ * @param length The number of source bytes.
+ * @param key The key's trit codes, repeated past keyLength (see DeltaKey::codes()).
+ * @param keyLength The number of key codes; must be non-zero.
+ * @param keyIndex The key position of the first letter in `in` (less than keyLength).
+ * @param out The destination; must hold standardEncodedSize(in, length) bytes.
+ * @return size_t The number of bytes written.
+ */
+size_t encodeKeyed(const unsigned char* in, size_t length, const unsigned char* key, size_t keyLength,
+                   size_t keyIndex, unsigned char* out) {
+    unsigned char* start = out;
+    size_t i = 0;
+
+    for (; i + ENTRY_WIDTH <= length; i++) {
+        const unsigned char c = in[i];
+        const GlyphEntry& entry = KEYED_BYTE_TABLE[key[keyIndex]][c];
+        std::memcpy(out, &entry, ENTRY_WIDTH);
+        out += entry.length;
+
+        keyIndex += (LETTER_CODE[c] != 0);
+        keyIndex &= size_t{0} - (keyIndex != keyLength);
+    }
+
+    for (; i < length; i++) {
+        const unsigned char c = in[i];
+        const GlyphEntry& entry = KEYED_BYTE_TABLE[key[keyIndex]][c];
+        std::memcpy(out, entry.bytes, entry.length);
+        out += entry.length;
+
+        keyIndex += (LETTER_CODE[c] != 0);
+        keyIndex &= size_t{0} - (keyIndex != keyLength);
+    }
+
+    return static_cast<size_t>(out - start);
+}
+
+/**
+ * @brief Byte-level Standard Mode decoder.
+ *
+ * Glyphs are recognised directly from their UTF-8 bytes (see tripletCode()), so nothing
+ * is copied or allocated per character. A triplet is only decoded when all nine of its
+ * bytes are present and valid; anything else, including a glyph run cut short at the end
+ * of the buffer, is copied through byte by byte.
+ *
+ * @param in The ciphertext bytes.
+ * @param length The number of ciphertext bytes.
+ * @param out The destination; must hold `length` bytes (decoding never grows the text).
+ * @return size_t The number of bytes written.
+ */
+size_t decodeStandard(const unsigned char* in, size_t length, unsigned char* out) {
+    unsigned char* start = out;
+    size_t i = 0;
+
+    while (i < length) {
+        if (in[i] == 0xE2 && length - i >= TRIPLET_SIZE) {
+            int code = tripletCode(in + i);
+            if (code >= 0) {
+                *out++ = static_cast<unsigned char>(TRIPLET_LETTER[code]);
+                i += TRIPLET_SIZE;
+                continue;
+            }
+        }
+
+        *out++ = in[i++];
+    }
+
+    return static_cast<size_t>(out - start);
+}
+
+/**
+ * @brief Byte-level Delta Mode decoder.
+ *
+ * Parses exactly like decodeStandard(), but each triplet code is looked up in
+ * INVERSE_TABLE together with the current key code. The key position only advances
+ * on decoded letters, mirroring encodeKeyed().
+ *
+ * @param in The ciphertext bytes.
+ * @param length The number of ciphertext bytes.
+ * @param key The key's trit codes, repeated past keyLength (see DeltaKey::codes()).
+ * @param keyLength The number of key codes; must be non-zero.
+ * @param keyIndex The key position of the first triplet in `in` (less than keyLength).
+ * @param out The destination; must hold `length` bytes.
+ * @return size_t The number of bytes written.
+ */
+size_t decodeKeyed(const unsigned char* in, size_t length, const unsigned char* key, size_t keyLength,
+                   size_t keyIndex, unsigned char* out) {
+    unsigned char* start = out;
+    size_t i = 0;
+
+    while (i < length) {
+        if (in[i] == 0xE2 && length - i >= TRIPLET_SIZE) {
+            int code = tripletCode(in + i);
+            if (code >= 0) {
+                *out++ = static_cast<unsigned char>(INVERSE_TABLE[key[keyIndex]][code]);
+                i += TRIPLET_SIZE;
+                if (++keyIndex == keyLength) keyIndex = 0;
+                continue;
+            }
+        }
+
+        *out++ = in[i++];
+    }
+
+    return static_cast<size_t>(out - start);
+}
+
+/**
+ * @brief Counts the triplets the decoders would decode, without writing anything.
+ *
+ * Follows the same greedy parse as decodeStandard(). Bytes between glyph runs are
+ * skipped with memchr() up to the next lead byte (E2).
+ *
+ * @param in The ciphertext bytes.
+ * @param length The number of ciphertext bytes.
+ * @return size_t The number of decoded letters; the plaintext is `length - 8 *` that long.
+ */
+size_t countTriplets(const unsigned char* in, size_t length) {
+    const unsigned char* end = in + length;
+    size_t triplets = 0;
+
+    while (in < end) {
+        in = static_cast<const unsigned char*>(std::memchr(in, 0xE2, static_cast<size_t>(end - in)));
+        if (!in) break;
+
+        if (end - in >= TRIPLET_SIZE && matchTriplet(in) >= 0) {
+            triplets++;
+            in += TRIPLET_SIZE;
+        } else {
+            in++;
+        }
+    }
+
+    return triplets;
+}
+
+/**
+ * @brief Returns how much of a piece of a longer ciphertext can be decoded before the
+ * rest arrives.
+ *
+ * A triplet can be cut by the end of the piece, so the tail from the start of the last
+ * unfinished triplet has to wait: a partial glyph (E2, or E2 96/97) and the glyphs of
+ * the final run past its last whole group of three. The decoders group a run in threes
+ * from its first glyph, so counting the run back to the start of the piece is enough as
+ * long as the piece starts on a group boundary. At most 8 bytes are left over.
+ *
+ * @param in The ciphertext piece; must start on a group boundary.
+ * @param length The number of bytes in the piece.
+ * @return size_t The length of the prefix that decodes the same as in the whole text.
+ */
+size_t decodableLength(const unsigned char* in, size_t length) {
+    size_t end = length;
+
+    if (end >= 1 && in[end - 1] == 0xE2) {
+        end -= 1;
+    } else if (end >= 2 && in[end - 2] == 0xE2 && (in[end - 1] == 0x96 || in[end - 1] == 0x97)) {
+        end -= 2;
+    }
+
+    size_t start = end;
+    while (start >= GLYPH_SIZE && glyphTrit(in + start - GLYPH_SIZE) >= 0) {
+        start -= GLYPH_SIZE;
+    }
+
+    return end - ((((end - start) / GLYPH_SIZE) % BASE) * GLYPH_SIZE);
+}
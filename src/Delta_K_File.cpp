@@ -0,0 +1,203 @@
+#include "Delta_K_File.hpp"
+#include "Delta_K_Engine.hpp"
+#include "Delta_K_Parallel.hpp"
+
+#include <iostream>
+#include <vector>
+
+#if defined(__unix__) || defined(__APPLE__)
+#define DELTA_K_MMAP
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <cerrno>
+#include <cstring>
+#endif
+
+/**
+ * @brief Checks whether this build can encode and decode through memory-mapped files.
+ *
+ * @return true On POSIX systems.
+ */
+bool mappedFilesAvailable() {
+#ifdef DELTA_K_MMAP
+    return true;
+#else
+    return false;
+#endif
+}
+
+#ifdef DELTA_K_MMAP
+
+/**
+ * @brief An open file and (once mapped) its mapping; both are released on destruction.
+ */
+struct MappedFile {
+    int fd = -1;
+    void* data = MAP_FAILED;
+    size_t length = 0;
+
+    ~MappedFile() {
+        if (data != MAP_FAILED) munmap(data, length);
+        if (fd >= 0) close(fd);
+    }
+};
+
+/**
+ * @brief Reports a failed system call on a file, with the reason from errno.
+ */
+static bool fileError(const char* action, const std::string& path) {
+    std::cerr << "Cannot " << action << " " << path << ": " << std::strerror(errno) << std::endl;
+    return false;
+}
+
+/**
+ * @brief Passes the hints for one mapping to the kernel (see MapHints).
+ */
+static void adviseMapping(void* data, size_t length, const MapHints& hints) {
+    if (hints.sequential) madvise(data, length, MADV_SEQUENTIAL);
+#ifdef MADV_HUGEPAGE
+    if (hints.hugePages) madvise(data, length, MADV_HUGEPAGE);
+#endif
+}
+
+/**
+ * @brief Grows a new, empty file to `length` bytes with its blocks allocated, so writes
+ * through a mapping of it cannot run out of space. Where posix_fallocate() is missing,
+ * the file is only resized.
+ *
+ * @return true If the file has its length; false with errno set otherwise.
+ */
+static bool reserveFile(int fd, size_t length) {
+#if defined(__linux__) || defined(__FreeBSD__)
+    const int error = posix_fallocate(fd, 0, static_cast<off_t>(length));
+    if (error == 0) return true;
+    errno = error;
+    return false;
+#else
+    return ftruncate(fd, static_cast<off_t>(length)) == 0;
+#endif
+}
+
+/**
+ * @brief Shared memory-mapped file codec for both directions.
+ *
+ * The input is mapped read-only and a first pass over it computes the exact output
+ * length (planEncode() or planDecode(), run in parallel). The output file then has its
+ * blocks reserved with posix_fallocate() and is mapped shared, and the kernels write
+ * straight into the mapping (encodeParallel() or decodeParallel()), so nothing is staged
+ * in memory and the output is never reallocated. Reserving the blocks up front turns a
+ * full disk into an error here rather than a SIGBUS in the middle of the kernels.
+ * The mapping is flushed with msync() before returning, so an I/O error while writing
+ * the pages back fails the call instead of being lost.
+ *
+ * Only regular files have a size to map; a pipe, FIFO or terminal as input is refused,
+ * since its st_size would read as empty.
+ */
+static bool codeMappedFile(bool encrypting, const std::string& inputPath, const std::string& outputPath,
+                           const std::string& key, const MapHints& hints, unsigned threads) {
+    MappedFile input;
+    MappedFile output;
+    struct stat inputInfo;
+    struct stat outputInfo;
+
+    input.fd = open(inputPath.c_str(), O_RDONLY);
+    if (input.fd < 0) return fileError("open input file", inputPath);
+    if (fstat(input.fd, &inputInfo) != 0) return fileError("read", inputPath);
+    if (!S_ISREG(inputInfo.st_mode)) {
+        std::cerr << "Cannot map " << inputPath << ": not a regular file" << std::endl;
+        return false;
+    }
+
+    // Truncating the output first would destroy the input if both are the same file.
+    if (stat(outputPath.c_str(), &outputInfo) == 0 && outputInfo.st_dev == inputInfo.st_dev &&
+        outputInfo.st_ino == inputInfo.st_ino) {
+        std::cerr << "Input and output are the same file: " << outputPath << std::endl;
+        return false;
+    }
+
+    input.length = static_cast<size_t>(inputInfo.st_size);
+    if (input.length) {
+        input.data = mmap(nullptr, input.length, PROT_READ, MAP_PRIVATE, input.fd, 0);
+        if (input.data == MAP_FAILED) return fileError("map", inputPath);
+        adviseMapping(input.data, input.length, hints);
+    }
+
+    const unsigned char* in = static_cast<const unsigned char*>(input.data);
+    const DeltaKey codes(key);
+    EncodePlan encodePlan;
+    DecodePlan decodePlan;
+
+    if (encrypting) {
+        encodePlan = planEncode(in, input.length, threads);
+        output.length = plannedEncodedSize(encodePlan);
+    } else {
+        decodePlan = planDecode(in, input.length, threads);
+        output.length = plannedDecodedSize(decodePlan);
+    }
+
+    output.fd = open(outputPath.c_str(), O_RDWR | O_CREAT | O_TRUNC, 0644);
+    if (output.fd < 0) return fileError("open output file", outputPath);
+    if (output.length == 0) return true;
+    if (!reserveFile(output.fd, output.length)) return fileError("reserve space for", outputPath);
+
+    output.data = mmap(nullptr, output.length, PROT_READ | PROT_WRITE, MAP_SHARED, output.fd, 0);
+    if (output.data == MAP_FAILED) return fileError("map", outputPath);
+    adviseMapping(output.data, output.length, hints);
+
+    unsigned char* out = static_cast<unsigned char*>(output.data);
+    if (encrypting) {
+        encodeParallel(encodePlan, in, codes.codes(), codes.length(), 0, out);
+    } else {
+        decodeParallel(decodePlan, in, codes.codes(), codes.length(), 0, out);
+    }
+
+    // A failed write-back through the mapping is only reported here; munmap() would drop it.
+    if (msync(output.data, output.length, MS_SYNC) != 0) return fileError("write", outputPath);
+
+    return true;
+}
+
+#else
+
+static bool codeMappedFile(bool, const std::string&, const std::string&, const std::string&, const MapHints&,
+                           unsigned) {
+    std::cerr << "Memory-mapped files are not available on this platform" << std::endl;
+    return false;
+}
+
+#endif
+
+/**
+ * @brief Encrypts a file into another through memory mappings (see encrypt()).
+ * Standard Mode for an empty key, Delta Mode otherwise.
+ *
+ * @param inputPath The plaintext file; a regular file, not a pipe or device.
+ * @param outputPath The ciphertext file; created or truncated, and never the input.
+ * @param key The keyword, or an empty string for Standard Mode.
+ * @param hints The madvise() hints for both mappings.
+ * @param threads The most threads to use; 0 uses defaultThreadCount().
+ * @return true If the output was written; otherwise the reason is printed to stderr.
+ */
+bool encryptMappedFile(const std::string& inputPath, const std::string& outputPath, const std::string& key,
+                       const MapHints& hints, unsigned threads) {
+    return codeMappedFile(true, inputPath, outputPath, key, hints, threads);
+}
+
+/**
+ * @brief Decrypts a file into another through memory mappings (see decrypt()).
+ * Standard Mode for an empty key, Delta Mode otherwise.
+ *
+ * @param inputPath The ciphertext file; a regular file, not a pipe or device.
+ * @param outputPath The plaintext file; created or truncated, and never the input.
+ * @param key The keyword the ciphertext was encrypted with, or an empty string.
+ * @param hints The madvise() hints for both mappings.
+ * @param threads The most threads to use; 0 uses defaultThreadCount().
+ * @return true If the output was written; otherwise the reason is printed to stderr.
+ */
+bool decryptMappedFile(const std::string& inputPath, const std::string& outputPath, const std::string& key,
+                       const MapHints& hints, unsigned threads) {
+    return codeMappedFile(false, inputPath, outputPath, key, hints, threads);
+}
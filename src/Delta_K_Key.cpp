@@ -0,0 +1,87 @@
+#include "Delta_K_Key.hpp"
+#include "Delta_K.hpp"
+#include "Delta_K_Tables.hpp"
+
+/**
+ * @brief Compiles a keyword the caller has already validated (see keyValidation()).
+ * Any non-letter becomes code 0, which leaves the matching plaintext letter unshifted.
+ *
+ * @param text The keyword, or an empty string for Standard Mode.
+ */
+DeltaKey::DeltaKey(std::string_view text) {
+    assign(text);
+}
+
+/**
+ * @brief Validates and compiles a keyword in one step.
+ *
+ * @param text The keyword: letters only, in either case, or empty for Standard Mode.
+ * @param key Receives the compiled key if the keyword is valid.
+ * @return true If every character of the keyword is a letter.
+ */
+bool DeltaKey::parse(std::string_view text, DeltaKey& key) {
+    for (char c : text) {
+        if (LETTER_CODE[static_cast<unsigned char>(c)] == 0) return false;
+    }
+
+    key.assign(text);
+    return true;
+}
+
+/**
+ * @brief Recompiles the key from a new keyword, reusing the key's storage.
+ * A key that has held a keyword at least as long allocates nothing.
+ *
+ * @param text The keyword, or an empty string for Standard Mode.
+ */
+void DeltaKey::assign(std::string_view text) {
+    keyLength = text.length();
+
+    if (keyLength == 0) {
+        pattern.clear();
+        return;
+    }
+
+    const size_t patternLength = KEY_PATTERN_ROWS * keyPatternStride(keyLength);
+    pattern.resize((patternLength + sizeof(PatternLine) - 1) / sizeof(PatternLine));
+    fillKeyPattern(text, reinterpret_cast<unsigned char*>(pattern.data()));
+}
+
+/**
+ * @brief Lays out a keyword the way the keyed kernels take it (see DeltaKey::codes()).
+ *
+ * Row 0 holds the letter codes; rows 1-3 hold (3 - trit) for the first, second and
+ * third glyph of each letter. Every row repeats the key for KEY_PATTERN_PADDING bytes
+ * past its end, and rows are keyPatternStride() bytes apart.
+ *
+ * @param text The keyword; must not be empty.
+ * @param pattern The destination; must hold KEY_PATTERN_ROWS * keyPatternStride() bytes.
+ */
+void fillKeyPattern(std::string_view text, unsigned char* pattern) {
+    const size_t keyLength = text.length();
+    const size_t stride = keyPatternStride(keyLength);
+
+    for (size_t i = 0; i < keyLength; i++) {
+        const unsigned char code = LETTER_CODE[static_cast<unsigned char>(text[i])];
+        pattern[i] = code;
+        pattern[stride + i] = static_cast<unsigned char>(BASE - (code / (BASE * BASE)));
+        pattern[(2 * stride) + i] = static_cast<unsigned char>(BASE - ((code / BASE) % BASE));
+        pattern[(3 * stride) + i] = static_cast<unsigned char>(BASE - (code % BASE));
+    }
+
+    for (size_t row = 0; row < KEY_PATTERN_ROWS; row++) {
+        unsigned char* bytes = pattern + (row * stride);
+        for (size_t i = keyLength; i < stride; i++) {
+            bytes[i] = bytes[i - keyLength];
+        }
+    }
+}
+
+/**
+ * @brief Returns the key's letter codes, repeated for KEY_PATTERN_PADDING bytes past
+ * length() and aligned to a cache line, followed by its negated trit rows (see
+ * fillKeyPattern()); null for an empty key.
+ */
+const unsigned char* DeltaKey::codes() const {
+    return pattern.empty() ? nullptr : reinterpret_cast<const unsigned char*>(pattern.data());
+}
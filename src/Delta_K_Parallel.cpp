@@ -0,0 +1,326 @@
+#include "Delta_K_Parallel.hpp"
+#include "Delta_K.hpp"
+#include "Delta_K_Dispatch.hpp"
+#include "Delta_K_Engine.hpp"
+#include "Delta_K_Tables.hpp"
+
+#include <thread>
+
+/**
+ * @brief The smallest chunk worth a thread of its own; smaller inputs use fewer threads.
+ */
+constexpr size_t PARALLEL_MIN_CHUNK = size_t{1} << 18;
+
+/**
+ * @brief Returns the number of threads to use when the caller does not choose one.
+ */
+unsigned defaultThreadCount() {
+    unsigned threads = std::thread::hardware_concurrency();
+    return threads ? threads : 1;
+}
+
+/**
+ * @brief Runs task(0) ... task(count - 1), each on its own thread; task(0) runs on the
+ * calling thread, so a single task never spawns one.
+ */
+template <typename Task>
+static void runChunks(size_t count, const Task& task) {
+    std::vector<std::thread> workers;
+    workers.reserve(count - 1);
+
+    for (size_t c = 1; c < count; c++) {
+        workers.emplace_back(task, c);
+    }
+    task(0);
+    for (std::thread& worker : workers) {
+        worker.join();
+    }
+}
+
+/**
+ * @brief Splits the input into chunks and counts the letters of every chunk in parallel.
+ *
+ * @param in The source bytes.
+ * @param length The number of source bytes.
+ * @param threads The most chunks (and threads) to use; 0 uses defaultThreadCount().
+ * @return EncodePlan The chunk bounds and the exclusive prefix sum of their letter counts.
+ */
+EncodePlan planEncode(const unsigned char* in, size_t length, unsigned threads) {
+    const KernelSet& kernels = activeKernels();
+    EncodePlan plan;
+    size_t chunks = threads ? threads : defaultThreadCount();
+
+    if (chunks > (length / PARALLEL_MIN_CHUNK)) chunks = length / PARALLEL_MIN_CHUNK;
+    if (chunks == 0) chunks = 1;
+
+    plan.inputStart.resize(chunks + 1);
+    plan.lettersBefore.resize(chunks + 1);
+    for (size_t c = 0; c <= chunks; c++) {
+        plan.inputStart[c] = c == chunks ? length : (length / chunks) * c;
+    }
+
+    // Each chunk stores its own count one slot ahead, which the scan below turns into
+    // the exclusive prefix sum.
+    plan.lettersBefore[0] = 0;
+    runChunks(chunks, [&](size_t c) {
+        const size_t chunkLength = plan.inputStart[c + 1] - plan.inputStart[c];
+        plan.lettersBefore[c + 1] = kernels.countLetters(in + plan.inputStart[c], chunkLength);
+    });
+    for (size_t c = 1; c <= chunks; c++) {
+        plan.lettersBefore[c] += plan.lettersBefore[c - 1];
+    }
+
+    return plan;
+}
+
+/**
+ * @brief Returns the exact ciphertext length of a planned input (see standardEncodedSize()).
+ */
+size_t plannedEncodedSize(const EncodePlan& plan) {
+    return plan.inputStart.back() + (plan.lettersBefore.back() * (TRIPLET_SIZE - 1));
+}
+
+/**
+ * @brief Encodes every chunk of a plan on its own thread.
+ *
+ * Chunk c starts writing at inputStart[c] + 8 * lettersBefore[c] and starts the key at
+ * (keyIndex + lettersBefore[c]) % keyLength, which is exactly where the serial encoder
+ * would be at that byte, so the output is byte-identical to it. Each chunk runs the
+ * active kernel (see activeKernels()).
+ *
+ * @param plan The chunks, from planEncode() over the same input.
+ * @param in The source bytes.
+ * @param key The key's trit codes (see DeltaKey::codes()), or null for Standard Mode.
+ * @param keyLength The number of key codes; must be non-zero if `key` is set.
+ * @param keyIndex The key position of the first letter in `in` (less than keyLength).
+ * @param out The destination; must hold plannedEncodedSize(plan) bytes.
+ * @return size_t The number of bytes written.
+ */
+size_t encodeParallel(const EncodePlan& plan, const unsigned char* in, const unsigned char* key, size_t keyLength,
+                      size_t keyIndex, unsigned char* out) {
+    const KernelSet& kernels = activeKernels();
+
+    runChunks(plan.inputStart.size() - 1, [&](size_t c) {
+        const unsigned char* chunk = in + plan.inputStart[c];
+        const size_t chunkLength = plan.inputStart[c + 1] - plan.inputStart[c];
+        unsigned char* chunkOut = out + plan.inputStart[c] + (plan.lettersBefore[c] * (TRIPLET_SIZE - 1));
+
+        if (key) {
+            kernels.encodeKeyed(chunk, chunkLength, key, keyLength, (keyIndex + plan.lettersBefore[c]) % keyLength,
+                                chunkOut);
+        } else {
+            kernels.encodeStandard(chunk, chunkLength, chunkOut);
+        }
+    });
+
+    return plannedEncodedSize(plan);
+}
+
+/**
+ * @brief Multithreaded encrypt(): Standard Mode for an empty key, Delta Mode otherwise.
+ * * The letters of every chunk are counted in parallel, an exclusive prefix sum gives each
+ * chunk its key offset and output offset, and the chunks are then encoded in parallel
+ * (see planEncode() and encodeParallel()). The result is byte-identical to encrypt().
+ * * @param plaintext The source string to encrypt.
+ * @param key The keyword, or an empty string for Standard Mode.
+ * @param threads The most threads to use; 0 uses defaultThreadCount().
+ * @return std::string The resulting string of glyphs.
+ */
+std::string encryptParallel(const std::string& plaintext, const std::string& key, unsigned threads) {
+    const unsigned char* in = reinterpret_cast<const unsigned char*>(plaintext.data());
+    const DeltaKey codes(key);
+    EncodePlan plan = planEncode(in, plaintext.length(), threads);
+    std::string ciphertext;
+
+    ciphertext.resize(plannedEncodedSize(plan));
+    encodeParallel(plan, in, codes.codes(), codes.length(), 0,
+                   reinterpret_cast<unsigned char*>(&ciphertext[0]));
+
+    return ciphertext;
+}
+
+/**
+ * @brief The glyph runs at the edges of one decode chunk, as the plan scan needs them.
+ */
+struct ChunkRuns {
+    size_t leading;
+    size_t trailing;
+    size_t triplets;
+};
+
+/**
+ * @brief Returns true if the byte is a UTF-8 continuation byte (10xxxxxx).
+ * A glyph never starts on one, so a chunk bound that is not on one never splits a glyph.
+ */
+static inline bool isContinuationByte(unsigned char c) {
+    return (c & 0xC0) == 0x80;
+}
+
+/**
+ * @brief Measures one chunk: the glyphs at its start and at its end, and the triplets a
+ * decoder run on the chunk alone would find (see countTriplets()).
+ */
+static ChunkRuns measureChunk(const unsigned char* in, size_t length) {
+    ChunkRuns runs;
+    size_t i = 0;
+
+    while (length - i >= GLYPH_SIZE && glyphTrit(in + i) >= 0) {
+        i += GLYPH_SIZE;
+    }
+    runs.leading = i / GLYPH_SIZE;
+
+    i = length;
+    while (i >= GLYPH_SIZE && glyphTrit(in + i - GLYPH_SIZE) >= 0) {
+        i -= GLYPH_SIZE;
+    }
+    runs.trailing = (length - i) / GLYPH_SIZE;
+
+    runs.triplets = countTriplets(in, length);
+
+    return runs;
+}
+
+/**
+ * @brief Splits the ciphertext into chunks that decode independently, in parallel.
+ *
+ * The even split points are moved forward onto UTF-8 lead bytes, so no glyph is cut.
+ * A triplet may still straddle a bound: the decoders group a glyph run in threes from
+ * its first glyph, so the phase at a bound is the number of glyphs of the run before it,
+ * modulo 3. Every chunk measures the glyphs at its edges in parallel, and a prefix scan
+ * over the chunks carries the run length across the bounds. A bound inside an unfinished
+ * triplet moves past it when the run completes it (the triplet goes to the chunk it
+ * starts in); otherwise the glyphs are copied through either way. The same scan sums
+ * the triplets per chunk, which gives each chunk its key offset and output offset.
+ *
+ * @param in The ciphertext bytes.
+ * @param length The number of ciphertext bytes.
+ * @param threads The most chunks (and threads) to use; 0 uses defaultThreadCount().
+ * @return DecodePlan The chunk bounds, their key offsets and their output offsets.
+ */
+DecodePlan planDecode(const unsigned char* in, size_t length, unsigned threads) {
+    DecodePlan plan;
+    size_t chunks = threads ? threads : defaultThreadCount();
+
+    if (chunks > (length / PARALLEL_MIN_CHUNK)) chunks = length / PARALLEL_MIN_CHUNK;
+    if (chunks == 0) chunks = 1;
+
+    // Bounds that had to move too far are dropped, so every chunk but a lone one spans at
+    // least half a minimum chunk (and so any chunk that is all glyphs holds a triplet).
+    std::vector<size_t> bounds(1, 0);
+    for (size_t c = 1; c < chunks; c++) {
+        size_t bound = (length / chunks) * c;
+        while (bound < length && isContinuationByte(in[bound])) bound++;
+
+        if (bound - bounds.back() >= PARALLEL_MIN_CHUNK / 2 && length - bound >= PARALLEL_MIN_CHUNK / 2) {
+            bounds.push_back(bound);
+        }
+    }
+    bounds.push_back(length);
+    chunks = bounds.size() - 1;
+
+    std::vector<ChunkRuns> runs(chunks);
+    runChunks(chunks, [&](size_t c) { runs[c] = measureChunk(in + bounds[c], bounds[c + 1] - bounds[c]); });
+
+    // Glyphs (not triplets) that chunk c skips because the chunk before it decodes them.
+    std::vector<size_t> skipped(chunks + 1, 0);
+    size_t carried = 0;
+    for (size_t c = 0; c < chunks; c++) {
+        const size_t phase = carried % BASE;
+        if (phase && runs[c].leading >= BASE - phase) skipped[c] = BASE - phase;
+
+        const bool whole = runs[c].leading * GLYPH_SIZE == bounds[c + 1] - bounds[c];
+        carried = whole ? carried + runs[c].leading : runs[c].trailing;
+    }
+
+    plan.inputStart.resize(chunks + 1);
+    plan.tripletsBefore.resize(chunks + 1);
+    plan.outputStart.resize(chunks + 1);
+    plan.inputStart[0] = 0;
+    plan.tripletsBefore[0] = 0;
+    plan.outputStart[0] = 0;
+
+    for (size_t c = 0; c < chunks; c++) {
+        const ChunkRuns& run = runs[c];
+        plan.inputStart[c + 1] = bounds[c + 1] + (skipped[c + 1] * GLYPH_SIZE);
+
+        // Only the leading run groups differently from the chunk decoded alone, and a
+        // triplet reaching into the next chunk is added on top.
+        size_t triplets = run.triplets - (run.leading / BASE) + ((run.leading - skipped[c]) / BASE);
+        if (skipped[c + 1]) triplets++;
+
+        plan.tripletsBefore[c + 1] = plan.tripletsBefore[c] + triplets;
+        plan.outputStart[c + 1] = plan.outputStart[c] + (plan.inputStart[c + 1] - plan.inputStart[c]) -
+                                  (triplets * (TRIPLET_SIZE - 1));
+    }
+
+    return plan;
+}
+
+/**
+ * @brief Returns the exact plaintext length of a planned ciphertext.
+ */
+size_t plannedDecodedSize(const DecodePlan& plan) {
+    return plan.outputStart.back();
+}
+
+/**
+ * @brief Decodes every chunk of a plan on its own thread.
+ *
+ * Chunk c starts writing at outputStart[c] and starts the key at
+ * (keyIndex + tripletsBefore[c]) % keyLength, so the output is byte-identical to the
+ * serial decoder. Each chunk runs the active kernel (see activeKernels()).
+ *
+ * @param plan The chunks, from planDecode() over the same input.
+ * @param in The ciphertext bytes.
+ * @param key The key's trit codes (see DeltaKey::codes()), or null for Standard Mode.
+ * @param keyLength The number of key codes; must be non-zero if `key` is set.
+ * @param keyIndex The key position of the first triplet in `in` (less than keyLength).
+ * @param out The destination; must hold plannedDecodedSize(plan) bytes.
+ * @return size_t The number of bytes written.
+ */
+size_t decodeParallel(const DecodePlan& plan, const unsigned char* in, const unsigned char* key, size_t keyLength,
+                      size_t keyIndex, unsigned char* out) {
+    const KernelSet& kernels = activeKernels();
+
+    runChunks(plan.inputStart.size() - 1, [&](size_t c) {
+        const unsigned char* chunk = in + plan.inputStart[c];
+        const size_t chunkLength = plan.inputStart[c + 1] - plan.inputStart[c];
+        unsigned char* chunkOut = out + plan.outputStart[c];
+
+        if (key) {
+            kernels.decodeKeyed(chunk, chunkLength, key, keyLength, (keyIndex + plan.tripletsBefore[c]) % keyLength,
+                                chunkOut);
+        } else {
+            kernels.decodeStandard(chunk, chunkLength, chunkOut);
+        }
+    });
+
+    return plannedDecodedSize(plan);
+}
+
+/**
+ * @brief Multithreaded decrypt(): Standard Mode for an empty key, Delta Mode otherwise.
+ * * Chunk bounds are resynchronised on glyph and triplet boundaries, a prefix scan gives
+ * each chunk its key offset and output offset, and the chunks are then decoded in
+ * parallel (see planDecode() and decodeParallel()). The result is byte-identical to decrypt().
+ * * Planning costs an extra counting pass, so a single chunk is handed to decrypt() instead.
+ * * @param ciphertext The string of glyphs (and punctuation) to decode.
+ * @param key The keyword the ciphertext was encrypted with, or an empty string.
+ * @param threads The most threads to use; 0 uses defaultThreadCount().
+ * @return std::string The recovered plaintext.
+ */
+std::string decryptParallel(const std::string& ciphertext, const std::string& key, unsigned threads) {
+    if (threads == 0) threads = defaultThreadCount();
+    if (threads == 1 || ciphertext.length() < 2 * PARALLEL_MIN_CHUNK) return decrypt(ciphertext, key);
+
+    const unsigned char* in = reinterpret_cast<const unsigned char*>(ciphertext.data());
+    const DeltaKey codes(key);
+    DecodePlan plan = planDecode(in, ciphertext.length(), threads);
+    std::string plaintext;
+
+    plaintext.resize(plannedDecodedSize(plan));
+    decodeParallel(plan, in, codes.codes(), codes.length(), 0,
+                   reinterpret_cast<unsigned char*>(&plaintext[0]));
+
+    return plaintext;
+}
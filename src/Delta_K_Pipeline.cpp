@@ -0,0 +1,348 @@
+#include "Delta_K_Pipeline.hpp"
+#include "Delta_K_Dispatch.hpp"
+#include "Delta_K_Engine.hpp"
+#include "Delta_K_Parallel.hpp"
+#include "Delta_K_Tables.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <cstring>
+#include <functional>
+#include <iostream>
+#include <istream>
+#include <memory>
+#include <ostream>
+#include <thread>
+#include <vector>
+
+/**
+ * @brief A bounded lock-free multi-producer, multi-consumer queue (Vyukov's design).
+ *
+ * Every cell carries a sequence number that tells producers and consumers whose turn
+ * it is, so a push or pop is a single compare-and-swap on the shared index plus one
+ * release store. push() and pop() spin (yielding) while the queue is full or empty.
+ */
+template <typename T>
+class BoundedQueue {
+public:
+    explicit BoundedQueue(size_t capacity) {
+        size_t size = 2;
+        while (size < capacity) size *= 2;
+
+        cells.reset(new Cell[size]);
+        mask = size - 1;
+        for (size_t i = 0; i < size; i++) {
+            cells[i].sequence.store(i, std::memory_order_relaxed);
+        }
+    }
+
+    bool tryPush(const T& value) {
+        size_t position = tail.load(std::memory_order_relaxed);
+        Cell* cell;
+
+        for (;;) {
+            cell = &cells[position & mask];
+            const size_t sequence = cell->sequence.load(std::memory_order_acquire);
+            const std::ptrdiff_t turn = static_cast<std::ptrdiff_t>(sequence - position);
+
+            if (turn == 0) {
+                if (tail.compare_exchange_weak(position, position + 1, std::memory_order_relaxed)) break;
+            } else if (turn < 0) {
+                return false;
+            } else {
+                position = tail.load(std::memory_order_relaxed);
+            }
+        }
+
+        cell->value = value;
+        cell->sequence.store(position + 1, std::memory_order_release);
+        return true;
+    }
+
+    bool tryPop(T& value) {
+        size_t position = head.load(std::memory_order_relaxed);
+        Cell* cell;
+
+        for (;;) {
+            cell = &cells[position & mask];
+            const size_t sequence = cell->sequence.load(std::memory_order_acquire);
+            const std::ptrdiff_t turn = static_cast<std::ptrdiff_t>(sequence - (position + 1));
+
+            if (turn == 0) {
+                if (head.compare_exchange_weak(position, position + 1, std::memory_order_relaxed)) break;
+            } else if (turn < 0) {
+                return false;
+            } else {
+                position = head.load(std::memory_order_relaxed);
+            }
+        }
+
+        value = cell->value;
+        cell->sequence.store(position + mask + 1, std::memory_order_release);
+        return true;
+    }
+
+    void push(const T& value) {
+        while (!tryPush(value)) std::this_thread::yield();
+    }
+
+    void pop(T& value) {
+        while (!tryPop(value)) std::this_thread::yield();
+    }
+
+private:
+    struct Cell {
+        std::atomic<size_t> sequence;
+        T value;
+    };
+
+    std::unique_ptr<Cell[]> cells;
+    size_t mask = 0;
+    alignas(64) std::atomic<size_t> tail{0};
+    alignas(64) std::atomic<size_t> head{0};
+};
+
+/**
+ * @brief One chunk in flight: its buffers, and where it sits in the stream.
+ */
+struct PipelineChunk {
+    std::vector<unsigned char> input;
+    std::vector<unsigned char> output;
+    size_t inputLength = 0;
+    size_t outputLength = 0;
+    size_t sequence = 0;
+};
+
+/**
+ * @brief The chunk index a worker receives to stop.
+ */
+constexpr size_t STOP_CHUNK = ~size_t{0};
+
+/**
+ * @brief The state the pipeline stages share.
+ *
+ * Chunks travel as indices into `chunks`: the reader takes one from `free`, fills it
+ * and queues it on `work`; a worker codes it and queues it on `done`; the writer puts
+ * the chunks back in stream order, writes them and returns them to `free`. The key
+ * ledger hands the key position from chunk to chunk: the worker of chunk s waits until
+ * `ledgerSequence` reaches s, takes `ledgerOffset` as its key position and moves the
+ * ledger on by its own letter (or triplet) count, which it counted beforehand.
+ */
+struct Pipeline {
+    explicit Pipeline(size_t count) : free(count), work(count), done(count) {}
+
+    std::vector<PipelineChunk> chunks;
+    BoundedQueue<size_t> free;
+    BoundedQueue<size_t> work;
+    BoundedQueue<size_t> done;
+
+    std::atomic<size_t> ledgerSequence{0};
+    size_t ledgerOffset = 0;
+
+    std::atomic<bool> readerDone{false};
+    std::atomic<size_t> chunkCount{0};
+    std::atomic<bool> failed{false};
+};
+
+/**
+ * @brief The reader stage: fills chunks from the stream in order.
+ *
+ * When decoding, a chunk ends on its last triplet boundary (see decodableLength()) and
+ * the cut-off tail, at most 8 bytes, opens the next chunk; the last chunk keeps it.
+ */
+static void readChunks(Pipeline& pipeline, std::istream& in, bool encrypting, size_t chunkSize,
+                       unsigned workers) {
+    unsigned char carried[TRIPLET_SIZE];
+    size_t carriedLength = 0;
+    size_t sequence = 0;
+    bool last = false;
+
+    while (!last) {
+        size_t index;
+        pipeline.free.pop(index);
+        PipelineChunk& chunk = pipeline.chunks[index];
+
+        std::memcpy(chunk.input.data(), carried, carriedLength);
+        in.read(reinterpret_cast<char*>(chunk.input.data() + carriedLength),
+                static_cast<std::streamsize>(chunkSize));
+
+        const size_t length = carriedLength + static_cast<size_t>(in.gcount());
+        last = !in || pipeline.failed.load(std::memory_order_relaxed);
+        if (in.bad()) pipeline.failed.store(true, std::memory_order_relaxed);
+
+        chunk.inputLength = (encrypting || last) ? length : decodableLength(chunk.input.data(), length);
+        carriedLength = length - chunk.inputLength;
+        std::memcpy(carried, chunk.input.data() + chunk.inputLength, carriedLength);
+
+        chunk.sequence = sequence++;
+        pipeline.work.push(index);
+    }
+
+    pipeline.chunkCount.store(sequence, std::memory_order_relaxed);
+    pipeline.readerDone.store(true, std::memory_order_release);
+    for (unsigned w = 0; w < workers; w++) {
+        pipeline.work.push(STOP_CHUNK);
+    }
+}
+
+/**
+ * @brief The worker stage: codes chunks with the active kernels until told to stop.
+ */
+static void codeChunks(Pipeline& pipeline, bool encrypting, const DeltaKey& key) {
+    const KernelSet& kernels = activeKernels();
+    const unsigned char* keyData = key.codes();
+    const size_t keyLength = key.length();
+
+    for (;;) {
+        size_t index;
+        pipeline.work.pop(index);
+        if (index == STOP_CHUNK) return;
+
+        PipelineChunk& chunk = pipeline.chunks[index];
+        const unsigned char* in = chunk.input.data();
+        unsigned char* out = chunk.output.data();
+        const size_t length = chunk.inputLength;
+
+        if (key.empty()) {
+            chunk.outputLength = encrypting ? kernels.encodeStandard(in, length, out)
+                                            : kernels.decodeStandard(in, length, out);
+        } else {
+            const size_t used = encrypting ? kernels.countLetters(in, length) : countTriplets(in, length);
+
+            while (pipeline.ledgerSequence.load(std::memory_order_acquire) != chunk.sequence) {
+                std::this_thread::yield();
+            }
+            const size_t keyIndex = pipeline.ledgerOffset;
+            pipeline.ledgerOffset = (keyIndex + used) % keyLength;
+            pipeline.ledgerSequence.store(chunk.sequence + 1, std::memory_order_release);
+
+            chunk.outputLength = encrypting ? kernels.encodeKeyed(in, length, keyData, keyLength, keyIndex, out)
+                                            : kernels.decodeKeyed(in, length, keyData, keyLength, keyIndex, out);
+        }
+
+        pipeline.done.push(index);
+    }
+}
+
+/**
+ * @brief The writer stage (on the calling thread): writes the coded chunks in stream
+ * order and recycles them. After a write error it keeps recycling without writing, so
+ * the other stages can wind down.
+ */
+static void writeChunks(Pipeline& pipeline, std::ostream& out) {
+    const size_t count = pipeline.chunks.size();
+    std::vector<size_t> arrived(count, STOP_CHUNK);
+    size_t next = 0;
+
+    while (!(pipeline.readerDone.load(std::memory_order_acquire) &&
+             next == pipeline.chunkCount.load(std::memory_order_relaxed))) {
+        size_t index;
+        if (!pipeline.done.tryPop(index)) {
+            std::this_thread::yield();
+            continue;
+        }
+
+        // At most `count` chunks are in flight, so their sequence numbers are distinct
+        // modulo `count`.
+        arrived[pipeline.chunks[index].sequence % count] = index;
+
+        while (arrived[next % count] != STOP_CHUNK) {
+            const size_t ready = arrived[next % count];
+            const PipelineChunk& chunk = pipeline.chunks[ready];
+
+            if (!pipeline.failed.load(std::memory_order_relaxed) &&
+                !out.write(reinterpret_cast<const char*>(chunk.output.data()),
+                           static_cast<std::streamsize>(chunk.outputLength))) {
+                pipeline.failed.store(true, std::memory_order_relaxed);
+            }
+
+            arrived[next % count] = STOP_CHUNK;
+            pipeline.free.push(ready);
+            next++;
+        }
+    }
+
+    if (!out.flush()) pipeline.failed.store(true, std::memory_order_relaxed);
+}
+
+/**
+ * @brief Shared pipelined codec for both directions.
+ *
+ * One reader thread, `workers` codec threads and the writer on the calling thread run
+ * at once, connected by bounded lock-free queues, so the stream moves at the speed of
+ * the slowest stage while memory stays at `chunksInFlight` chunks. The worker count is
+ * capped to the chunks a worker can get (see PipelineOptions), with a note on stderr.
+ */
+static bool codePipelined(bool encrypting, std::istream& in, std::ostream& out, const std::string& key,
+                          const PipelineOptions& options) {
+    const unsigned requested = options.workers ? options.workers : defaultThreadCount();
+    const size_t chunkSize = options.chunkSize ? options.chunkSize : PipelineOptions().chunkSize;
+    const size_t inputBytes = chunkSize + TRIPLET_SIZE;
+    const size_t outputBytes = encrypting ? chunkSize * TRIPLET_SIZE : chunkSize + TRIPLET_SIZE;
+    const size_t budget = options.memoryBudget
+                              ? options.memoryBudget
+                              : std::max(PIPELINE_MEMORY_BUDGET, PIPELINE_WORKER_BUDGET * requested);
+    const size_t affordable = std::max<size_t>(2, budget / (inputBytes + outputBytes));
+    const size_t count =
+        options.chunksInFlight ? options.chunksInFlight : std::min((size_t{2} * requested) + 2, affordable);
+    const DeltaKey codes(key);
+
+    // Workers without a chunk to code would only wait, so do not start them.
+    const unsigned workers = static_cast<unsigned>(std::min<size_t>(requested, std::max<size_t>(1, count - 1)));
+    if (workers < requested) {
+        std::cerr << "Pipeline: using " << workers << " of " << requested << " workers, since only " << count
+                  << " chunks are in flight" << std::endl;
+    }
+
+    // Room for every worker's stop signal on top of the chunks.
+    Pipeline pipeline(count + workers);
+    pipeline.chunks.resize(count);
+    for (size_t c = 0; c < count; c++) {
+        PipelineChunk& chunk = pipeline.chunks[c];
+        chunk.input.resize(inputBytes);
+        chunk.output.resize(outputBytes);
+        pipeline.free.push(c);
+    }
+
+    std::vector<std::thread> threads;
+    threads.reserve(workers + 1);
+    threads.emplace_back(readChunks, std::ref(pipeline), std::ref(in), encrypting, chunkSize, workers);
+    for (unsigned w = 0; w < workers; w++) {
+        threads.emplace_back(codeChunks, std::ref(pipeline), encrypting, std::cref(codes));
+    }
+
+    writeChunks(pipeline, out);
+    for (std::thread& thread : threads) {
+        thread.join();
+    }
+
+    return !pipeline.failed.load();
+}
+
+/**
+ * @brief Encrypts a stream with a reader, parallel encoders and an ordered writer
+ * (see encrypt()). Standard Mode for an empty key, Delta Mode otherwise.
+ *
+ * @param in The plaintext source.
+ * @param out The ciphertext destination.
+ * @param key The keyword, or an empty string for Standard Mode.
+ * @param options The number of workers, the chunk size and the chunks in flight.
+ * @return true If the whole input was read and written.
+ */
+bool encryptPipelined(std::istream& in, std::ostream& out, const std::string& key, const PipelineOptions& options) {
+    return codePipelined(true, in, out, key, options);
+}
+
+/**
+ * @brief Decrypts a stream with a reader, parallel decoders and an ordered writer
+ * (see decrypt()). Standard Mode for an empty key, Delta Mode otherwise.
+ *
+ * @param in The ciphertext source.
+ * @param out The plaintext destination.
+ * @param key The keyword the ciphertext was encrypted with, or an empty string.
+ * @param options The number of workers, the chunk size and the chunks in flight.
+ * @return true If the whole input was read and written.
+ */
+bool decryptPipelined(std::istream& in, std::ostream& out, const std::string& key, const PipelineOptions& options) {
+    return codePipelined(false, in, out, key, options);
+}
@@ -0,0 +1,389 @@
+#include "Delta_K_Engine.hpp"
+#include "Delta_K_Kernels.hpp"
+#include "Delta_K_Tables.hpp"
+
+#include <cstdint>
+#include <cstring>
+
+#ifdef DELTA_K_X86
+#include <immintrin.h>
+#endif
+
+/**
+ * @brief Checks whether the CPU supports the SSE4.2 kernel tier.
+ *
+ * @return true If the SSE4.2 kernels can run on this host.
+ */
+bool cpuHasSSE42() {
+#if defined(DELTA_K_X86) && (defined(__GNUC__) || defined(__clang__))
+    return __builtin_cpu_supports("sse4.2");
+#elif defined(DELTA_K_X86) && defined(_MSC_VER)
+    int info[4];
+    __cpuid(info, 1);
+    return (info[2] & (1 << 20)) != 0;
+#else
+    return false;
+#endif
+}
+
+#ifdef DELTA_K_X86
+
+/**
+ * @brief The number of source bytes one SSE block holds.
+ */
+constexpr size_t SSE_BYTES = 16;
+
+/**
+ * @brief The source bytes an encode step needs: every byte of the block must still have
+ * ENTRY_WIDTH bytes of input after it, so its fixed-width store stays inside the output.
+ */
+constexpr size_t ENCODE_BLOCK_MARGIN = SSE_BYTES + ENTRY_WIDTH;
+
+/**
+ * @brief Returns 0xFF in every lane of the block that holds a letter, 0 elsewhere.
+ * SSE has no unsigned byte compare, so `index <= 25` is tested as min(index, 25) == index.
+ */
+DELTA_K_TARGET("sse4.2")
+static inline __m128i letterLanes128(__m128i block) {
+    const __m128i index = _mm_sub_epi8(_mm_or_si128(block, _mm_set1_epi8(0x20)), _mm_set1_epi8('a'));
+    return _mm_cmpeq_epi8(_mm_min_epu8(index, _mm_set1_epi8(ALPHABET_LENGTH - 1)), index);
+}
+
+/**
+ * @brief Returns a bit per byte of the block, set where the byte is a letter.
+ */
+DELTA_K_TARGET("sse4.2")
+static inline unsigned letterMask128(__m128i block) {
+    return static_cast<unsigned>(_mm_movemask_epi8(letterLanes128(block)));
+}
+
+/**
+ * @brief SSE4.2 letter counter (see countLetters()).
+ * Per-lane counters are folded into 64-bit totals with psadbw before they can overflow.
+ *
+ * @param in The source bytes.
+ * @param length The number of source bytes.
+ * @return size_t The number of letters (A-Z, a-z).
+ */
+DELTA_K_TARGET("sse4.2")
+size_t countLettersSSE42(const unsigned char* in, size_t length) {
+    const __m128i zero = _mm_setzero_si128();
+    __m128i totals = zero;
+    size_t i = 0;
+
+    while (length - i >= SSE_BYTES) {
+        size_t blocks = (length - i) / SSE_BYTES;
+        if (blocks > 255) blocks = 255;
+
+        __m128i counts = zero;
+        for (size_t b = 0; b < blocks; b++, i += SSE_BYTES) {
+            const __m128i block = _mm_loadu_si128(reinterpret_cast<const __m128i*>(in + i));
+            counts = _mm_sub_epi8(counts, letterLanes128(block));
+        }
+        totals = _mm_add_epi64(totals, _mm_sad_epu8(counts, zero));
+    }
+
+    alignas(16) uint64_t lanes[2];
+    _mm_store_si128(reinterpret_cast<__m128i*>(lanes), totals);
+
+    return static_cast<size_t>(lanes[0] + lanes[1]) + countLetters(in + i, length - i);
+}
+
+/**
+ * @brief SSE4.2 Standard Mode encoder, 16 source bytes per step.
+ *
+ * Blocks without letters are copied with one store; blocks of 16 letters are expanded
+ * with a fixed 9-byte output step; mixed blocks go through STANDARD_TABLE byte by byte.
+ * encodeStandard() finishes the tail.
+ *
+ * @param in The source bytes.
+ * @param length The number of source bytes.
+ * @param out The destination; must hold standardEncodedSize(in, length) bytes.
+ * @return size_t The number of bytes written.
+ */
+DELTA_K_TARGET("sse4.2")
+size_t encodeStandardSSE42(const unsigned char* in, size_t length, unsigned char* out) {
+    unsigned char* start = out;
+    size_t i = 0;
+
+    for (; length - i >= ENCODE_BLOCK_MARGIN; i += SSE_BYTES) {
+        const __m128i block = _mm_loadu_si128(reinterpret_cast<const __m128i*>(in + i));
+        const unsigned letters = letterMask128(block);
+
+        if (letters == 0) {
+            _mm_storeu_si128(reinterpret_cast<__m128i*>(out), block);
+            out += SSE_BYTES;
+        } else if (letters == 0xFFFF) {
+            for (size_t k = 0; k < SSE_BYTES; k++) {
+                std::memcpy(out + (k * TRIPLET_SIZE), &STANDARD_TABLE[in[i + k]], ENTRY_WIDTH);
+            }
+            out += SSE_BYTES * TRIPLET_SIZE;
+        } else {
+            for (size_t k = 0; k < SSE_BYTES; k++) {
+                const GlyphEntry& entry = STANDARD_TABLE[in[i + k]];
+                std::memcpy(out, &entry, ENTRY_WIDTH);
+                out += entry.length;
+            }
+        }
+    }
+
+    out += encodeStandard(in + i, length - i, out);
+
+    return static_cast<size_t>(out - start);
+}
+
+/**
+ * @brief SSE4.2 Delta Mode encoder, 16 source bytes per step.
+ *
+ * Blocks without letters are copied with one store and leave the key where it is;
+ * blocks of 16 letters take 16 consecutive key codes and a fixed 9-byte output step;
+ * mixed blocks go through KEYED_BYTE_TABLE byte by byte, with the key position wrapped
+ * once per block (the key codes repeat past keyLength). encodeKeyed() finishes the tail.
+ *
+ * @param in The source bytes.
+ * @param length The number of source bytes.
+ * @param key The key's trit codes, repeated past keyLength (see DeltaKey::codes()).
+ * @param keyLength The number of key codes; must be non-zero.
+ * @param keyIndex The key position of the first letter in `in` (less than keyLength).
+ * @param out The destination; must hold standardEncodedSize(in, length) bytes.
+ * @return size_t The number of bytes written.
+ */
+DELTA_K_TARGET("sse4.2")
+size_t encodeKeyedSSE42(const unsigned char* in, size_t length, const unsigned char* key, size_t keyLength,
+                        size_t keyIndex, unsigned char* out) {
+    unsigned char* start = out;
+    size_t i = 0;
+
+    for (; length - i >= ENCODE_BLOCK_MARGIN; i += SSE_BYTES) {
+        const __m128i block = _mm_loadu_si128(reinterpret_cast<const __m128i*>(in + i));
+        const unsigned letters = letterMask128(block);
+
+        if (letters == 0) {
+            _mm_storeu_si128(reinterpret_cast<__m128i*>(out), block);
+            out += SSE_BYTES;
+        } else if (letters == 0xFFFF) {
+            for (size_t k = 0; k < SSE_BYTES; k++) {
+                std::memcpy(out + (k * TRIPLET_SIZE), &KEYED_BYTE_TABLE[key[keyIndex + k]][in[i + k]],
+                            ENTRY_WIDTH);
+            }
+            out += SSE_BYTES * TRIPLET_SIZE;
+            keyIndex += SSE_BYTES;
+            if (keyIndex >= keyLength) keyIndex %= keyLength;
+        } else {
+            for (size_t k = 0; k < SSE_BYTES; k++) {
+                const unsigned char c = in[i + k];
+                const GlyphEntry& entry = KEYED_BYTE_TABLE[key[keyIndex]][c];
+                std::memcpy(out, &entry, ENTRY_WIDTH);
+                out += entry.length;
+
+                keyIndex += (LETTER_CODE[c] != 0);
+            }
+            if (keyIndex >= keyLength) keyIndex %= keyLength;
+        }
+    }
+
+    out += encodeKeyed(in + i, length - i, key, keyLength, keyIndex, out);
+
+    return static_cast<size_t>(out - start);
+}
+
+/**
+ * @brief Returns a bit per byte of the 64 bytes at `in`, set where a valid glyph starts.
+ */
+DELTA_K_TARGET("sse4.2")
+static inline uint64_t glyphStarts128(const unsigned char* in) {
+    uint64_t starts = 0;
+
+    for (size_t c = 0; c < DECODE_BLOCK_BYTES; c += SSE_BYTES) {
+        const __m128i first = _mm_loadu_si128(reinterpret_cast<const __m128i*>(in + c));
+        const __m128i second = _mm_loadu_si128(reinterpret_cast<const __m128i*>(in + c + 1));
+        const __m128i third = _mm_loadu_si128(reinterpret_cast<const __m128i*>(in + c + 2));
+
+        const __m128i lead = _mm_cmpeq_epi8(first, _mm_set1_epi8(static_cast<char>(0xE2)));
+        const __m128i middle96 = _mm_cmpeq_epi8(second, _mm_set1_epi8(static_cast<char>(0x96)));
+        const __m128i middle97 = _mm_cmpeq_epi8(second, _mm_set1_epi8(static_cast<char>(0x97)));
+        const __m128i finalB2BC = _mm_or_si128(_mm_cmpeq_epi8(third, _mm_set1_epi8(static_cast<char>(0xB2))),
+                                               _mm_cmpeq_epi8(third, _mm_set1_epi8(static_cast<char>(0xBC))));
+        const __m128i final86 = _mm_cmpeq_epi8(third, _mm_set1_epi8(static_cast<char>(0x86)));
+        const __m128i valid = _mm_and_si128(
+            lead, _mm_or_si128(_mm_and_si128(middle96, finalB2BC), _mm_and_si128(middle97, final86)));
+
+        starts |= static_cast<uint64_t>(static_cast<unsigned>(_mm_movemask_epi8(valid))) << c;
+    }
+
+    return starts;
+}
+
+/**
+ * @brief Returns the trit of the glyph whose final byte is in each lane.
+ */
+DELTA_K_TARGET("sse4.2")
+static inline __m128i finalTrits128(const unsigned char* in) {
+    const __m128i bytes = _mm_loadu_si128(reinterpret_cast<const __m128i*>(in));
+    return _mm_shuffle_epi8(_mm_loadu_si128(reinterpret_cast<const __m128i*>(FINAL_NIBBLE_TRIT)),
+                            _mm_and_si128(bytes, _mm_set1_epi8(0x0F)));
+}
+
+/**
+ * @brief Returns 0xFF in the lanes whose bit is set in a 16-bit mask.
+ */
+DELTA_K_TARGET("sse4.2")
+static inline __m128i maskLanes128(unsigned bits) {
+    const __m128i select = _mm_set1_epi64x(static_cast<long long>(0x8040201008040201ULL));
+    const __m128i spread = _mm_shuffle_epi8(_mm_cvtsi32_si128(static_cast<int>(bits)),
+                                            _mm_set_epi64x(0x0101010101010101LL, 0));
+    return _mm_cmpeq_epi8(_mm_and_si128(spread, select), select);
+}
+
+/**
+ * @brief Loads the shuffle controls for two groups of 8 lanes into one 16-lane control.
+ */
+DELTA_K_TARGET("sse4.2")
+static inline __m128i laneShuffle128(const LaneShuffle& low, const LaneShuffle& high) {
+    return _mm_unpacklo_epi64(_mm_loadl_epi64(reinterpret_cast<const __m128i*>(low.lanes)),
+                              _mm_add_epi8(_mm_loadl_epi64(reinterpret_cast<const __m128i*>(high.lanes)),
+                                           _mm_set1_epi8(8)));
+}
+
+/**
+ * @brief Shared SSE4.2 decode loop for both modes, 64 ciphertext bytes per block.
+ *
+ * Each block's glyph starts are validated in-register and parsed into triplet starts
+ * and kept bytes by parseGlyphBlock(), with no branch on where runs begin or end. Every
+ * lane computes the letter of a triplet starting there from the final bytes 2, 5 and 8
+ * lanes on, '@' + 9 * trit1 + 3 * trit2 + trit3; in Delta Mode each trit is first
+ * offset by the negated key trit (3 - k, see negatedKeyTrits()) of its triplet, spread
+ * to the groups of 8 lanes that hold a triplet start, and reduced modulo 3 with a
+ * shuffle. The letters replace the triplet starts and the kept bytes are packed 8 lanes
+ * at a time through COMPACT_SHUFFLES. Blocks without glyphs are copied whole.
+ */
+DELTA_K_TARGET("sse4.2")
+static size_t decodeSSE42(const unsigned char* in, size_t length, const unsigned char* key, size_t keyLength,
+                          size_t keyIndex, unsigned char* out) {
+    unsigned char* start = out;
+    const __m128i letterBase = _mm_set1_epi8('A' - 1);
+    const __m128i mod3 = _mm_setr_epi8(0, 1, 2, 0, 1, 2, 0, 1, 2, 0, 1, 2, 0, 1, 2, 0);
+    GlyphCarry carry;
+    size_t i = 0;
+    uint64_t starts = length >= DECODE_BLOCK_MARGIN ? glyphStarts128(in) : 0;
+
+    for (; length - i >= DECODE_BLOCK_MARGIN; i += DECODE_BLOCK_BYTES) {
+        const uint64_t nextStarts = glyphStarts128(in + i + DECODE_BLOCK_BYTES);
+        const GlyphBlock block = parseGlyphBlock(starts, nextStarts, carry);
+        starts = nextStarts;
+
+        if (block.keep == ~uint64_t{0} && block.triplets == 0) {
+            for (size_t c = 0; c < DECODE_BLOCK_BYTES; c += SSE_BYTES) {
+                _mm_storeu_si128(reinterpret_cast<__m128i*>(out + c),
+                                 _mm_loadu_si128(reinterpret_cast<const __m128i*>(in + i + c)));
+            }
+            out += DECODE_BLOCK_BYTES;
+            continue;
+        }
+
+        __m128i groupKeys[BASE];
+        if (key) {
+            const __m128i spread = _mm_loadl_epi64(
+                reinterpret_cast<const __m128i*>(SPREAD_SHUFFLES[occupiedGroups(block.triplets)].lanes));
+            for (int g = 0; g < BASE; g++) {
+                const __m128i negated =
+                    _mm_loadl_epi64(reinterpret_cast<const __m128i*>(negatedKeyTrits(key, keyLength, g) + keyIndex));
+                groupKeys[g] = _mm_shuffle_epi8(negated, spread);
+            }
+            keyIndex += countBits64(block.triplets);
+            if (keyIndex >= keyLength) keyIndex %= keyLength;
+        }
+
+        for (size_t c = 0; c < DECODE_BLOCK_BYTES; c += SSE_BYTES) {
+            const unsigned char* chunk = in + i + c;
+            __m128i trits[BASE] = {finalTrits128(chunk + 2), finalTrits128(chunk + 5), finalTrits128(chunk + 8)};
+
+            if (key) {
+                const __m128i broadcast = _mm_set_epi64x(static_cast<long long>(0x0101010101010101ULL * ((c / 8) + 1)),
+                                                         static_cast<long long>(0x0101010101010101ULL * (c / 8)));
+                for (int g = 0; g < BASE; g++) {
+                    trits[g] = _mm_shuffle_epi8(mod3, _mm_add_epi8(trits[g], _mm_shuffle_epi8(groupKeys[g], broadcast)));
+                }
+            }
+
+            __m128i code = _mm_add_epi8(_mm_add_epi8(trits[0], trits[0]), _mm_add_epi8(trits[0], trits[1]));
+            code = _mm_add_epi8(_mm_add_epi8(code, code), _mm_add_epi8(code, trits[2]));
+
+            const unsigned triplets = static_cast<unsigned>(block.triplets >> c) & 0xFFFF;
+            const unsigned keep = static_cast<unsigned>(block.keep >> c) & 0xFFFF;
+            const __m128i bytes = _mm_blendv_epi8(_mm_loadu_si128(reinterpret_cast<const __m128i*>(chunk)),
+                                                  _mm_add_epi8(code, letterBase), maskLanes128(triplets));
+            const __m128i packed = _mm_shuffle_epi8(
+                bytes, laneShuffle128(COMPACT_SHUFFLES[keep & 0xFF], COMPACT_SHUFFLES[keep >> 8]));
+
+            _mm_storel_epi64(reinterpret_cast<__m128i*>(out), packed);
+            out += countBits(keep & 0xFF);
+            _mm_storel_epi64(reinterpret_cast<__m128i*>(out), _mm_unpackhi_epi64(packed, packed));
+            out += countBits(keep >> 8);
+        }
+    }
+
+    i += glyphSpill(carry);
+
+    if (key) {
+        out += decodeKeyed(in + i, length - i, key, keyLength, keyIndex, out);
+    } else {
+        out += decodeStandard(in + i, length - i, out);
+    }
+
+    return static_cast<size_t>(out - start);
+}
+
+/**
+ * @brief SSE4.2 Standard Mode decoder (see decodeSSE42()).
+ *
+ * @param in The ciphertext bytes.
+ * @param length The number of ciphertext bytes.
+ * @param out The destination; must hold `length` bytes.
+ * @return size_t The number of bytes written.
+ */
+size_t decodeStandardSSE42(const unsigned char* in, size_t length, unsigned char* out) {
+    return decodeSSE42(in, length, nullptr, 0, 0, out);
+}
+
+/**
+ * @brief SSE4.2 Delta Mode decoder (see decodeSSE42()).
+ *
+ * @param in The ciphertext bytes.
+ * @param length The number of ciphertext bytes.
+ * @param key The key's trit codes, repeated past keyLength (see DeltaKey::codes()).
+ * @param keyLength The number of key codes; must be non-zero.
+ * @param keyIndex The key position of the first triplet in `in` (less than keyLength).
+ * @param out The destination; must hold `length` bytes.
+ * @return size_t The number of bytes written.
+ */
+size_t decodeKeyedSSE42(const unsigned char* in, size_t length, const unsigned char* key, size_t keyLength,
+                        size_t keyIndex, unsigned char* out) {
+    return decodeSSE42(in, length, key, keyLength, keyIndex, out);
+}
+
+#else
+
+size_t countLettersSSE42(const unsigned char* in, size_t length) {
+    return countLetters(in, length);
+}
+
+size_t encodeStandardSSE42(const unsigned char* in, size_t length, unsigned char* out) {
+    return encodeStandard(in, length, out);
+}
+
+size_t encodeKeyedSSE42(const unsigned char* in, size_t length, const unsigned char* key, size_t keyLength,
+                        size_t keyIndex, unsigned char* out) {
+    return encodeKeyed(in, length, key, keyLength, keyIndex, out);
+}
+
+size_t decodeStandardSSE42(const unsigned char* in, size_t length, unsigned char* out) {
+    return decodeStandard(in, length, out);
+}
+
+size_t decodeKeyedSSE42(const unsigned char* in, size_t length, const unsigned char* key, size_t keyLength,
+                        size_t keyIndex, unsigned char* out) {
+    return decodeKeyed(in, length, key, keyLength, keyIndex, out);
+}
+
+#endif
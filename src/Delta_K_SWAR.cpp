@@ -0,0 +1,290 @@
+#include "Delta_K_Engine.hpp"
+#include "Delta_K_Tables.hpp"
+
+#include <cstdint>
+#include <cstring>
+
+/**
+ * @brief The number of source bytes one SWAR word holds.
+ */
+constexpr size_t WORD_BYTES = sizeof(uint64_t);
+
+/**
+ * @brief 0x01 in every byte of a word.
+ */
+constexpr uint64_t ONES = 0x0101010101010101ULL;
+
+/**
+ * @brief 0x80 in every byte of a word; SWAR tests leave their per-byte result in these bits.
+ */
+constexpr uint64_t HIGH_BITS = ONES * 0x80;
+
+/**
+ * @brief The source bytes an encode step needs: every byte of the word must still have
+ * ENTRY_WIDTH bytes of input after it, so its fixed-width store stays inside the output.
+ */
+constexpr size_t ENCODE_WORD_MARGIN = WORD_BYTES + ENTRY_WIDTH;
+
+/**
+ * @brief The source bytes a decode step needs: a word copied in full may be up to
+ * 9 times larger than its output, so 8 spare output bytes need 72 remaining input bytes.
+ */
+constexpr size_t DECODE_WORD_MARGIN = WORD_BYTES * TRIPLET_SIZE;
+
+/**
+ * @brief Loads 8 bytes as a word with byte 0 in the low bits, on any byte order.
+ * Compilers turn this into a single load on little-endian hosts.
+ */
+static inline uint64_t loadWord(const unsigned char* p) {
+    return static_cast<uint64_t>(p[0]) | (static_cast<uint64_t>(p[1]) << 8) | (static_cast<uint64_t>(p[2]) << 16) |
+           (static_cast<uint64_t>(p[3]) << 24) | (static_cast<uint64_t>(p[4]) << 32) |
+           (static_cast<uint64_t>(p[5]) << 40) | (static_cast<uint64_t>(p[6]) << 48) |
+           (static_cast<uint64_t>(p[7]) << 56);
+}
+
+/**
+ * @brief Flags (with 0x80) every byte of the word that is a letter, A-Z or a-z.
+ *
+ * After folding to lowercase, the low 7 bits of each byte are compared against 'a' and
+ * 'z' by adding a bias that carries into bit 7; the bias never carries across bytes.
+ * Bytes with bit 7 already set are not ASCII and never letters.
+ */
+static inline uint64_t letterBits(uint64_t word) {
+    const uint64_t folded = word | (ONES * 0x20);
+    const uint64_t low = folded & ~HIGH_BITS;
+    const uint64_t atLeastA = low + (ONES * (0x80 - 'a'));
+    const uint64_t pastZ = low + (ONES * (0x80 - 'z' - 1));
+    return atLeastA & ~pastZ & ~folded & HIGH_BITS;
+}
+
+/**
+ * @brief Flags (with 0x80) every byte of the word equal to `value`, without false positives.
+ */
+static inline uint64_t matchBits(uint64_t word, unsigned char value) {
+    const uint64_t diff = word ^ (ONES * value);
+    return ~(((diff & ~HIGH_BITS) + ~HIGH_BITS) | diff) & HIGH_BITS;
+}
+
+/**
+ * @brief Returns the number of flagged bytes in a word produced by letterBits() or matchBits().
+ */
+static inline unsigned countFlagged(uint64_t bits) {
+    return static_cast<unsigned>(((bits >> 7) * ONES) >> 56);
+}
+
+/**
+ * @brief Returns the number of bytes before the first flagged byte (bits must be non-zero).
+ */
+static inline unsigned leadingUnflagged(uint64_t bits) {
+    return countFlagged(((bits & (~bits + 1)) - 1) & HIGH_BITS);
+}
+
+/**
+ * @brief SWAR letter counter (see countLetters()), 8 source bytes per word.
+ *
+ * @param in The source bytes.
+ * @param length The number of source bytes.
+ * @return size_t The number of letters (A-Z, a-z).
+ */
+size_t countLettersSWAR(const unsigned char* in, size_t length) {
+    size_t letters = 0;
+    size_t i = 0;
+
+    for (; length - i >= WORD_BYTES; i += WORD_BYTES) {
+        letters += countFlagged(letterBits(loadWord(in + i)));
+    }
+
+    return letters + countLetters(in + i, length - i);
+}
+
+/**
+ * @brief SWAR Standard Mode encoder, 8 source bytes per 64-bit word.
+ *
+ * Words without letters are copied whole; words of 8 letters are expanded with a fixed
+ * 9-byte output step, so the stores do not wait on each entry's length; mixed words go
+ * through STANDARD_TABLE byte by byte. encodeStandard() finishes the tail.
+ *
+ * @param in The source bytes.
+ * @param length The number of source bytes.
+ * @param out The destination; must hold standardEncodedSize(in, length) bytes.
+ * @return size_t The number of bytes written.
+ */
+size_t encodeStandardSWAR(const unsigned char* in, size_t length, unsigned char* out) {
+    unsigned char* start = out;
+    size_t i = 0;
+
+    for (; length - i >= ENCODE_WORD_MARGIN; i += WORD_BYTES) {
+        const uint64_t letters = letterBits(loadWord(in + i));
+
+        if (letters == 0) {
+            std::memcpy(out, in + i, WORD_BYTES);
+            out += WORD_BYTES;
+        } else if (letters == HIGH_BITS) {
+            for (size_t k = 0; k < WORD_BYTES; k++) {
+                std::memcpy(out + (k * TRIPLET_SIZE), &STANDARD_TABLE[in[i + k]], ENTRY_WIDTH);
+            }
+            out += WORD_BYTES * TRIPLET_SIZE;
+        } else {
+            for (size_t k = 0; k < WORD_BYTES; k++) {
+                const GlyphEntry& entry = STANDARD_TABLE[in[i + k]];
+                std::memcpy(out, &entry, ENTRY_WIDTH);
+                out += entry.length;
+            }
+        }
+    }
+
+    out += encodeStandard(in + i, length - i, out);
+
+    return static_cast<size_t>(out - start);
+}
+
+/**
+ * @brief SWAR Delta Mode encoder, 8 source bytes per 64-bit word.
+ *
+ * Words without letters are copied whole and leave the key where it is; words of 8
+ * letters take 8 consecutive key codes and a fixed 9-byte output step; mixed words go
+ * through KEYED_BYTE_TABLE byte by byte, with the key position wrapped once per word
+ * (the key codes repeat past keyLength). encodeKeyed() finishes the tail.
+ *
+ * @param in The source bytes.
+ * @param length The number of source bytes.
+ * @param key The key's trit codes, repeated past keyLength (see DeltaKey::codes()).
+ * @param keyLength The number of key codes; must be non-zero.
+ * @param keyIndex The key position of the first letter in `in` (less than keyLength).
+ * @param out The destination; must hold standardEncodedSize(in, length) bytes.
+ * @return size_t The number of bytes written.
+ */
+size_t encodeKeyedSWAR(const unsigned char* in, size_t length, const unsigned char* key, size_t keyLength,
+                       size_t keyIndex, unsigned char* out) {
+    unsigned char* start = out;
+    size_t i = 0;
+
+    for (; length - i >= ENCODE_WORD_MARGIN; i += WORD_BYTES) {
+        const uint64_t letters = letterBits(loadWord(in + i));
+
+        if (letters == 0) {
+            std::memcpy(out, in + i, WORD_BYTES);
+            out += WORD_BYTES;
+        } else if (letters == HIGH_BITS) {
+            for (size_t k = 0; k < WORD_BYTES; k++) {
+                std::memcpy(out + (k * TRIPLET_SIZE), &KEYED_BYTE_TABLE[key[keyIndex + k]][in[i + k]],
+                            ENTRY_WIDTH);
+            }
+            out += WORD_BYTES * TRIPLET_SIZE;
+            keyIndex += WORD_BYTES;
+            if (keyIndex >= keyLength) keyIndex %= keyLength;
+        } else {
+            for (size_t k = 0; k < WORD_BYTES; k++) {
+                const unsigned char c = in[i + k];
+                const GlyphEntry& entry = KEYED_BYTE_TABLE[key[keyIndex]][c];
+                std::memcpy(out, &entry, ENTRY_WIDTH);
+                out += entry.length;
+
+                keyIndex += (LETTER_CODE[c] != 0);
+            }
+            if (keyIndex >= keyLength) keyIndex %= keyLength;
+        }
+    }
+
+    out += encodeKeyed(in + i, length - i, key, keyLength, keyIndex, out);
+
+    return static_cast<size_t>(out - start);
+}
+
+/**
+ * @brief Decodes the run of whole triplets at a glyph lead byte, once the word scan
+ * of decodeSWAR() has stopped on one.
+ *
+ * Triplets are matched with matchTriplet() until the run ends or fewer than 9 bytes
+ * remain. A lead byte that does not start a full triplet is copied on its own, which
+ * keeps the greedy parse of decodeStandard().
+ *
+ * @param in The ciphertext bytes.
+ * @param length The number of ciphertext bytes; at least TRIPLET_SIZE must remain after `i`.
+ * @param i The position of the lead byte; advanced past the bytes consumed.
+ * @param key The key's trit codes (see DeltaKey::codes()), or null for Standard Mode.
+ * @param keyLength The number of key codes.
+ * @param keyIndex The key position of the first triplet; advanced by one per triplet.
+ * @param out The destination; advanced past the bytes written.
+ */
+static inline void decodeTripletRun(const unsigned char* in, size_t length, size_t& i, const unsigned char* key,
+                                    size_t keyLength, size_t& keyIndex, unsigned char*& out) {
+    int code = matchTriplet(in + i);
+    if (code < 0) {
+        *out++ = in[i++];
+        return;
+    }
+
+    do {
+        if (key) {
+            *out++ = static_cast<unsigned char>(INVERSE_TABLE[key[keyIndex]][code]);
+            if (++keyIndex == keyLength) keyIndex = 0;
+        } else {
+            *out++ = static_cast<unsigned char>(TRIPLET_LETTER[code]);
+        }
+        i += TRIPLET_SIZE;
+    } while (length - i >= TRIPLET_SIZE && (code = matchTriplet(in + i)) >= 0);
+}
+
+/**
+ * @brief Shared SWAR decode loop for both modes.
+ *
+ * Passthrough bytes are skipped a word at a time: each word is copied whole and the
+ * output advances to its first glyph lead byte (E2). At a lead byte, the run of whole
+ * triplets is decoded by decodeTripletRun().
+ */
+static size_t decodeSWAR(const unsigned char* in, size_t length, const unsigned char* key, size_t keyLength,
+                         size_t keyIndex, unsigned char* out) {
+    unsigned char* start = out;
+    size_t i = 0;
+
+    while (length - i >= DECODE_WORD_MARGIN) {
+        const uint64_t leads = matchBits(loadWord(in + i), 0xE2);
+
+        if ((leads & 0xFF) == 0) {
+            const unsigned run = leads ? leadingUnflagged(leads) : static_cast<unsigned>(WORD_BYTES);
+            std::memcpy(out, in + i, WORD_BYTES);
+            out += run;
+            i += run;
+            continue;
+        }
+
+        decodeTripletRun(in, length, i, key, keyLength, keyIndex, out);
+    }
+
+    if (key) {
+        out += decodeKeyed(in + i, length - i, key, keyLength, keyIndex, out);
+    } else {
+        out += decodeStandard(in + i, length - i, out);
+    }
+
+    return static_cast<size_t>(out - start);
+}
+
+/**
+ * @brief SWAR Standard Mode decoder (see decodeSWAR()).
+ *
+ * @param in The ciphertext bytes.
+ * @param length The number of ciphertext bytes.
+ * @param out The destination; must hold `length` bytes.
+ * @return size_t The number of bytes written.
+ */
+size_t decodeStandardSWAR(const unsigned char* in, size_t length, unsigned char* out) {
+    return decodeSWAR(in, length, nullptr, 0, 0, out);
+}
+
+/**
+ * @brief SWAR Delta Mode decoder (see decodeSWAR()).
+ *
+ * @param in The ciphertext bytes.
+ * @param length The number of ciphertext bytes.
+ * @param key The key's trit codes, repeated past keyLength (see DeltaKey::codes()).
+ * @param keyLength The number of key codes; must be non-zero.
+ * @param keyIndex The key position of the first triplet in `in` (less than keyLength).
+ * @param out The destination; must hold `length` bytes.
+ * @return size_t The number of bytes written.
+ */
+size_t decodeKeyedSWAR(const unsigned char* in, size_t length, const unsigned char* key, size_t keyLength,
+                       size_t keyIndex, unsigned char* out) {
+    return decodeSWAR(in, length, key, keyLength, keyIndex, out);
+}
@@ -0,0 +1,194 @@
+#include "Delta_K_Stream.hpp"
+#include "Delta_K_Dispatch.hpp"
+#include "Delta_K_Engine.hpp"
+#include "Delta_K_Tables.hpp"
+
+#include <cstring>
+
+/**
+ * @brief Creates an encoder: Standard Mode for an empty key, Delta Mode otherwise.
+ *
+ * @param key The keyword; the caller validates it (see keyValidation()).
+ */
+DeltaKEncoder::DeltaKEncoder(const std::string& key) : key(key) {}
+
+/**
+ * @brief Creates an encoder from a compiled key (see DeltaKey).
+ */
+DeltaKEncoder::DeltaKEncoder(const DeltaKey& key) : key(key) {}
+
+/**
+ * @brief Encrypts the next piece of the stream.
+ *
+ * @param plaintext The next source bytes.
+ * @return std::string_view Their ciphertext, valid until the next call.
+ */
+std::string_view DeltaKEncoder::feed(std::string_view plaintext) {
+    if (output.size() < plaintext.length() * TRIPLET_SIZE) output.resize(plaintext.length() * TRIPLET_SIZE);
+
+    const size_t written = feed(plaintext, reinterpret_cast<char*>(output.data()));
+    return {reinterpret_cast<const char*>(output.data()), written};
+}
+
+/**
+ * @brief Encrypts the next piece of the stream into the caller's buffer.
+ *
+ * Every piece is encoded by the active kernel (see activeKernels()). The key position
+ * is advanced by the letters of the piece, which the output growth gives away (8 bytes
+ * per letter).
+ *
+ * @param plaintext The next source bytes.
+ * @param out The destination; must hold 9 bytes per source byte.
+ * @return size_t The number of bytes written.
+ */
+size_t DeltaKEncoder::feed(std::string_view plaintext, char* out) {
+    const KernelSet& kernels = activeKernels();
+    const unsigned char* in = reinterpret_cast<const unsigned char*>(plaintext.data());
+    unsigned char* dest = reinterpret_cast<unsigned char*>(out);
+    const size_t length = plaintext.length();
+
+    if (key.empty()) return kernels.encodeStandard(in, length, dest);
+
+    const size_t written = kernels.encodeKeyed(in, length, key.codes(), key.length(), keyIndex, dest);
+    keyIndex = (keyIndex + ((written - length) / (TRIPLET_SIZE - 1))) % key.length();
+
+    return written;
+}
+
+/**
+ * @brief Ends the stream and restarts the key, so the encoder can take a new one.
+ * Encoding never holds bytes back, so there is nothing left to write.
+ *
+ * @return std::string_view An empty view.
+ */
+std::string_view DeltaKEncoder::finish() {
+    keyIndex = 0;
+    return {};
+}
+
+/**
+ * @brief Ends the stream into the caller's buffer (see finish()).
+ *
+ * @return size_t 0; nothing is ever held back.
+ */
+size_t DeltaKEncoder::finish(char*) {
+    keyIndex = 0;
+    return 0;
+}
+
+/**
+ * @brief Creates a decoder: Standard Mode for an empty key, Delta Mode otherwise.
+ *
+ * @param key The keyword; the caller validates it (see keyValidation()).
+ */
+DeltaKDecoder::DeltaKDecoder(const std::string& key) : key(key) {}
+
+/**
+ * @brief Creates a decoder from a compiled key (see DeltaKey).
+ */
+DeltaKDecoder::DeltaKDecoder(const DeltaKey& key) : key(key) {}
+
+/**
+ * @brief Decodes whole triplets with the active kernel and advances the key position by
+ * the triplets decoded, which the output shrinkage gives away (8 bytes per triplet).
+ */
+size_t DeltaKDecoder::decodeInto(const unsigned char* in, size_t length, unsigned char* out) {
+    const KernelSet& kernels = activeKernels();
+
+    if (key.empty()) return kernels.decodeStandard(in, length, out);
+
+    size_t written = kernels.decodeKeyed(in, length, key.codes(), key.length(), keyIndex, out);
+    keyIndex = (keyIndex + ((length - written) / (TRIPLET_SIZE - 1))) % key.length();
+
+    return written;
+}
+
+/**
+ * @brief Decrypts the next piece of the stream.
+ *
+ * @param ciphertext The next ciphertext bytes.
+ * @return std::string_view Their plaintext, valid until the next call.
+ */
+std::string_view DeltaKDecoder::feed(std::string_view ciphertext) {
+    if (output.size() < ciphertext.length() + pendingLength) output.resize(ciphertext.length() + pendingLength);
+
+    const size_t written = feed(ciphertext, reinterpret_cast<char*>(output.data()));
+    return {reinterpret_cast<const char*>(output.data()), written};
+}
+
+/**
+ * @brief Decrypts the next piece of the stream into the caller's buffer.
+ *
+ * The tail held back from the last call is finished first, by borrowing up to one
+ * triplet from the front of the piece; the rest of the piece is then decoded in place
+ * up to its last triplet boundary (see decodableLength()), and its tail held back.
+ *
+ * @param ciphertext The next ciphertext bytes.
+ * @param out The destination; must hold the piece plus 8 bytes (the held-back tail).
+ * @return size_t The number of bytes written.
+ */
+size_t DeltaKDecoder::feed(std::string_view ciphertext, char* out) {
+    const unsigned char* in = reinterpret_cast<const unsigned char*>(ciphertext.data());
+    unsigned char* dest = reinterpret_cast<unsigned char*>(out);
+    size_t length = ciphertext.length();
+    size_t written = 0;
+
+    while (pendingLength && length) {
+        const size_t borrowed = length < TRIPLET_SIZE ? length : TRIPLET_SIZE;
+        const size_t held = pendingLength;
+
+        std::memcpy(pending + held, in, borrowed);
+        const size_t total = held + borrowed;
+        const size_t ready = decodableLength(pending, total);
+
+        written += decodeInto(pending, ready, dest + written);
+        if (ready >= held) {
+            // The held-back tail is resolved; the piece continues on a group boundary.
+            in += ready - held;
+            length -= ready - held;
+            pendingLength = 0;
+        } else {
+            std::memmove(pending, pending + ready, total - ready);
+            pendingLength = total - ready;
+            in += borrowed;
+            length -= borrowed;
+        }
+    }
+
+    if (length) {
+        const size_t ready = decodableLength(in, length);
+
+        written += decodeInto(in, ready, dest + written);
+        std::memcpy(pending, in + ready, length - ready);
+        pendingLength = length - ready;
+    }
+
+    return written;
+}
+
+/**
+ * @brief Ends the stream: copies through whatever was held back (a cut-off glyph run is
+ * not a triplet) and restarts the key, so the decoder can take a new stream.
+ *
+ * @return std::string_view The last plaintext bytes, valid until the next call.
+ */
+std::string_view DeltaKDecoder::finish() {
+    if (output.size() < pendingLength) output.resize(pendingLength);
+
+    const size_t written = finish(reinterpret_cast<char*>(output.data()));
+    return {reinterpret_cast<const char*>(output.data()), written};
+}
+
+/**
+ * @brief Ends the stream into the caller's buffer (see finish()).
+ *
+ * @param out The destination; must hold 8 bytes.
+ * @return size_t The number of bytes written.
+ */
+size_t DeltaKDecoder::finish(char* out) {
+    const size_t written = decodeInto(pending, pendingLength, reinterpret_cast<unsigned char*>(out));
+    pendingLength = 0;
+    keyIndex = 0;
+
+    return written;
+}
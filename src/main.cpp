@@ -15,23 +15,65 @@
  */
 
 #include "Delta_K.hpp"
+#include "Delta_K_AsyncIO.hpp"
+#include "Delta_K_Dispatch.hpp"
+#include "Delta_K_File.hpp"
+#include "Delta_K_Pipeline.hpp"
+#include "Delta_K_Stream.hpp"
 
+#include <cctype>
+#include <cstdlib>
+#include <filesystem>
+#include <fstream>
 #include <iostream>
 #include <string>
+#include <string_view>
 #include <limits>
+#include <vector>
+
+/**
+ * @brief The options given on the command line (see parseArguments()).
+ * A mode of 'e' or 'd' runs the program without the menu; 0 keeps it interactive.
+ * An empty io picks the I/O method from the files (see runStream()).
+ */
+struct CommandLine {
+    char mode = 0;
+    std::string key;
+    std::string input;
+    std::string output;
+    std::string io;
+    bool hugePages = false;
+    unsigned threads = 0;
+};
+
+/**
+ * @brief The number of source bytes read (and coded) per block when streaming.
+ */
+constexpr size_t STREAM_BLOCK = size_t{1} << 20;
 
 void selectEncrypt();
 void selectDecrypt();
+bool parseArguments(int argc, char* argv[], CommandLine& options);
+int runStream(const CommandLine& options);
+bool encryptStream(std::istream& in, std::ostream& out, const std::string& key);
+bool decryptStream(std::istream& in, std::ostream& out, const std::string& key);
 
 /**
  * @brief The main entry point for the Delta-K cipher program.
  * * Handles user interaction, input collection for plaintext and key,
  * validation of the key, and routing to the appropriate encryption function.
- * * @return int Execution status code.
+ * With `-e` or `-d` it skips the menu and streams a file or stdin instead (see runStream()).
+ * * @param argc The number of command-line arguments.
+ * @param argv The command-line arguments (see parseArguments()).
+ * @return int Execution status code.
  */
-int main() {
+int main(int argc, char* argv[]) {
+    CommandLine options;
     int userInput;
 
+    if (!parseArguments(argc, argv, options)) return 1;
+    if (options.mode) return runStream(options);
+
     std::cout << "Welcome to the DELTA-K Cipher Program!" << std::endl;
 
     do {
@@ -87,20 +129,301 @@ void selectEncrypt() {
 
 /**
  * @brief Handles the user interface logic for the decryption process.
- * * Prompts the user to input the glyph-based ciphertext. It calls the decryption 
- * function to reverse the substitution and outputs the recovered plaintext 
- * to the console.
+ * * Prompts the user to input the glyph-based ciphertext and an optional key. It validates
+ * the key, selects the appropriate decryption mode (Standard or Delta-K) to reverse the
+ * substitution, and outputs the recovered plaintext to the console.
  */
 void selectDecrypt() {
     std::string plaintext;
     std::string ciphertext;
+    std::string key;
 
     std::cout << "Please enter ciphertext to decode:" << std::endl;
     std::getline(std::cin, ciphertext);
 
-    plaintext = decrypt(ciphertext);
+    do {
+        std::cout << "Enter key (0 for normal cipher):" << std::endl;
+        std::cin >> key;
+
+        if (key == "0") {
+            plaintext = decrypt(ciphertext);
+        } else if (!keyValidation(key)) {
+            std::cout << "Key invalid. Try again." << std::endl;
+        } else {
+            plaintext = decrypt(ciphertext, key);
+        }
+    } while (!(keyValidation(key) || key == "0"));
 
     std::cout << "Decoded plaintext:" << std::endl;
     std::cout << plaintext << std::endl;
 }
 
+/**
+ * @brief Prints the command-line synopsis to stderr.
+ */
+static void printUsage(const char* program) {
+    std::cerr << "Usage: " << program << " [--tier scalar|swar|sse4.2|avx2|avx512]" << std::endl
+              << "       " << program << " -e|-d [-k KEY] [-i FILE] [-o FILE] [--tier NAME]" << std::endl
+              << "  -e, -d   encrypt or decrypt without the menu" << std::endl
+              << "  -k KEY   Delta Mode key (letters only); Standard Mode without it" << std::endl
+              << "  -i FILE  read from FILE instead of stdin" << std::endl
+              << "  -o FILE  write to FILE instead of stdout" << std::endl
+              << "  --io stream|mmap|uring|pread|pipeline  how input and output are processed (default: mmap for"
+              << " two files)" << std::endl
+              << "  -j N     codec threads for mmap and pipeline (default: one per core)" << std::endl
+              << "  --huge-pages      ask for huge pages on memory-mapped files" << std::endl;
+}
+
+/**
+ * @brief Applies the command-line options.
+ * * `--tier NAME` forces the codec kernels to one tier (scalar, swar, sse4.2, avx2 or
+ * avx512), like the DELTA_K_TIER environment variable; useful for benchmarking and for
+ * isolating a kernel bug. `-e` or `-d` picks a mode and skips the menu; `-k`, `-i` and
+ * `-o` give its key, input file and output file, and need one of them. `-` for a file
+ * means stdin or stdout. `--io` picks the file I/O method, `-j` the number of codec
+ * threads, and `--huge-pages` adds the huge-page hint to memory mappings.
+ * * @param argc The number of command-line arguments.
+ * @param argv The command-line arguments.
+ * @param options Receives the mode, key and files.
+ * @return true If every option was valid and applied.
+ * @return false If an option was unknown, or the tier cannot run on this CPU.
+ */
+bool parseArguments(int argc, char* argv[], CommandLine& options) {
+    bool streamOption = false;
+
+    for (int i = 1; i < argc; i++) {
+        std::string option = argv[i];
+        KernelTier tier;
+
+        if (option == "--huge-pages") {
+            options.hugePages = true;
+            streamOption = true;
+            continue;
+        }
+
+        if (option == "-e" || option == "-d") {
+            if (options.mode && options.mode != option[1]) {
+                std::cerr << "Choose either -e or -d, not both" << std::endl;
+                return false;
+            }
+            options.mode = option[1];
+            continue;
+        }
+
+        if ((option != "--tier" && option != "--io" && option != "-j" && option != "-k" && option != "-i" &&
+             option != "-o") ||
+            i + 1 >= argc) {
+            printUsage(argv[0]);
+            return false;
+        }
+
+        std::string value = argv[++i];
+        if (option == "-k") {
+            if (!keyValidation(value)) {
+                std::cerr << "Key invalid: " << value << std::endl;
+                return false;
+            }
+            options.key = value;
+            streamOption = true;
+        } else if (option == "-i") {
+            options.input = value;
+            streamOption = true;
+        } else if (option == "-o") {
+            options.output = value;
+            streamOption = true;
+        } else if (option == "--io") {
+            if (value != "stream" && value != "mmap" && value != "uring" && value != "pread" && value != "pipeline") {
+                std::cerr << "Unknown I/O method: " << value << std::endl;
+                return false;
+            }
+            options.io = value;
+            streamOption = true;
+        } else if (option == "-j") {
+            char* end;
+            const unsigned long threads = std::strtoul(value.c_str(), &end, 10);
+            if (value.empty() || !std::isdigit(static_cast<unsigned char>(value[0])) || *end || threads == 0 ||
+                threads > 1024) {
+                std::cerr << "Invalid thread count: " << value << std::endl;
+                return false;
+            }
+            options.threads = static_cast<unsigned>(threads);
+            streamOption = true;
+        } else if (!parseTier(value, tier)) {
+            std::cerr << "Unknown tier: " << value << std::endl;
+            return false;
+        } else if (!selectTier(tier)) {
+            std::cerr << "Tier not supported on this CPU: " << value << std::endl;
+            return false;
+        }
+    }
+
+    if (streamOption && !options.mode) {
+        std::cerr << "-k, -i, -o, -j, --io and --huge-pages need -e or -d" << std::endl;
+        printUsage(argv[0]);
+        return false;
+    }
+
+    return true;
+}
+
+/**
+ * @brief Checks whether an input and an output can be memory-mapped: the input is a
+ * regular file, and the output is one or does not exist yet.
+ */
+static bool regularFiles(const std::string& input, const std::string& output) {
+    std::error_code error;
+    const std::filesystem::file_status outputStatus = std::filesystem::status(output, error);
+
+    return std::filesystem::is_regular_file(input, error) &&
+           (!std::filesystem::exists(outputStatus) || std::filesystem::is_regular_file(outputStatus));
+}
+
+/**
+ * @brief Checks whether two paths name the same existing file (same device and inode
+ * on POSIX), so truncating the output would destroy the input.
+ */
+static bool sameFile(const std::string& input, const std::string& output) {
+    std::error_code error;
+    return std::filesystem::exists(output, error) && std::filesystem::equivalent(input, output, error);
+}
+
+/**
+ * @brief Runs the non-interactive mode: opens the input and output and streams one
+ * through the encoder or decoder.
+ * * When both are named regular files, they are memory-mapped instead (see
+ * encryptMappedFile()), unless `--io stream` asks otherwise; `--io mmap` insists on it.
+ * A pipe, FIFO or device (`-i <(cmd)`, `/dev/stdin`) is always streamed by default. `--io uring` and
+ * `--io pread` run two files through the block pipeline instead (see
+ * encryptFileAsync()), overlapped on io_uring or synchronous on plain pread()/pwrite(). `--io pipeline` runs
+ * files or pipes through a reader, parallel codec workers and an ordered writer (see
+ * encryptPipelined()).
+ * * @param options The parsed command line; its mode must be 'e' or 'd'.
+ * @return int Execution status code: 0 on success, 1 if a file or the stream failed.
+ */
+int runStream(const CommandLine& options) {
+    const bool namedFiles = !options.input.empty() && options.input != "-" && !options.output.empty() &&
+                            options.output != "-";
+
+    if (!options.io.empty() && options.io != "stream" && options.io != "pipeline" && !namedFiles) {
+        std::cerr << "--io " << options.io << " needs both -i and -o files" << std::endl;
+        return 1;
+    }
+
+    if (options.io == "uring" || options.io == "pread") {
+        AsyncOptions async;
+        async.backend = options.io == "uring" ? IoBackend::Uring : IoBackend::Pread;
+
+        if (async.backend == IoBackend::Uring && !uringAvailable()) {
+            std::cerr << "io_uring is not available, using pread/pwrite" << std::endl;
+        }
+
+        bool ok = options.mode == 'e' ? encryptFileAsync(options.input, options.output, options.key, async)
+                                      : decryptFileAsync(options.input, options.output, options.key, async);
+        return ok ? 0 : 1;
+    }
+
+    if (options.io == "mmap" || (options.io.empty() && namedFiles && mappedFilesAvailable() &&
+                                 regularFiles(options.input, options.output))) {
+        MapHints hints;
+        hints.hugePages = options.hugePages;
+
+        bool ok = options.mode == 'e'
+                      ? encryptMappedFile(options.input, options.output, options.key, hints, options.threads)
+                      : decryptMappedFile(options.input, options.output, options.key, hints, options.threads);
+        return ok ? 0 : 1;
+    }
+
+    std::ios::sync_with_stdio(false);
+
+    std::ifstream inFile;
+    std::ofstream outFile;
+    std::istream* in = &std::cin;
+    std::ostream* out = &std::cout;
+
+    if (!options.input.empty() && options.input != "-") {
+        inFile.open(options.input, std::ios::binary);
+        if (!inFile) {
+            std::cerr << "Cannot open input file: " << options.input << std::endl;
+            return 1;
+        }
+        in = &inFile;
+    }
+
+    if (!options.output.empty() && options.output != "-") {
+        // Opening the output truncates it, which would destroy the input before a byte is read.
+        if (in == &inFile && sameFile(options.input, options.output)) {
+            std::cerr << "Input and output are the same file: " << options.output << std::endl;
+            return 1;
+        }
+        outFile.open(options.output, std::ios::binary | std::ios::trunc);
+        if (!outFile) {
+            std::cerr << "Cannot open output file: " << options.output << std::endl;
+            return 1;
+        }
+        out = &outFile;
+    }
+
+    bool ok;
+    if (options.io == "pipeline") {
+        PipelineOptions pipeline;
+        pipeline.workers = options.threads;
+
+        ok = options.mode == 'e' ? encryptPipelined(*in, *out, options.key, pipeline)
+                                 : decryptPipelined(*in, *out, options.key, pipeline);
+    } else {
+        ok = options.mode == 'e' ? encryptStream(*in, *out, options.key) : decryptStream(*in, *out, options.key);
+    }
+
+    if (!ok) {
+        std::cerr << (options.mode == 'e' ? "Encryption" : "Decryption") << " failed: I/O error" << std::endl;
+        return 1;
+    }
+
+    return 0;
+}
+
+/**
+ * @brief Runs a stream through a DeltaKEncoder or DeltaKDecoder block by block.
+ * * @param in The source.
+ * @param out The destination.
+ * @param codec The encoder or decoder, with its key.
+ * @return true If the whole input was read and written.
+ */
+template <typename Codec>
+static bool runCodec(std::istream& in, std::ostream& out, Codec& codec) {
+    std::vector<char> block(STREAM_BLOCK);
+
+    while (in.read(block.data(), STREAM_BLOCK) || in.gcount() > 0) {
+        std::string_view result = codec.feed({block.data(), static_cast<size_t>(in.gcount())});
+        if (!out.write(result.data(), static_cast<std::streamsize>(result.size()))) return false;
+    }
+
+    std::string_view result = codec.finish();
+    if (!out.write(result.data(), static_cast<std::streamsize>(result.size()))) return false;
+
+    return !in.bad() && out.flush();
+}
+
+/**
+ * @brief Encrypts a stream block by block (see DeltaKEncoder).
+ * * @param in The plaintext source.
+ * @param out The ciphertext destination.
+ * @param key The keyword, or an empty string for Standard Mode.
+ * @return true If the whole input was read and written.
+ */
+bool encryptStream(std::istream& in, std::ostream& out, const std::string& key) {
+    DeltaKEncoder encoder(key);
+    return runCodec(in, out, encoder);
+}
+
+/**
+ * @brief Decrypts a stream block by block (see DeltaKDecoder).
+ * * @param in The ciphertext source.
+ * @param out The plaintext destination.
+ * @param key The keyword, or an empty string for Standard Mode.
+ * @return true If the whole input was read and written.
+ */
+bool decryptStream(std::istream& in, std::ostream& out, const std::string& key) {
+    DeltaKDecoder decoder(key);
+    return runCodec(in, out, decoder);
+}
@@ -0,0 +1,29 @@
+#include "Delta_K_Tests.hpp"
+#include "Delta_K_Codec.hpp"
+
+/**
+ * @brief The codec every check shares, so its buffer and key cache carry over from input
+ * to input (and more keys pass through it than it has slots).
+ */
+static DeltaKCodec& sharedCodec() {
+    static DeltaKCodec codec;
+    return codec;
+}
+
+static void checkCodecEncrypt(std::mt19937&, const std::string& text, const std::string& key) {
+    check(sharedCodec().encrypt(text, key) == referenceEncrypt(text, key),
+          describe("DeltaKCodec::encrypt", text.length(), key));
+}
+
+static void checkCodecDecrypt(std::mt19937&, const std::string& ciphertext, const std::string& key) {
+    check(sharedCodec().decrypt(ciphertext, key) == referenceDecrypt(ciphertext, key),
+          describe("DeltaKCodec::decrypt", ciphertext.length(), key));
+}
+
+/**
+ * @brief The reusable codec, with its persistent buffer and compiled key cache.
+ */
+void testCodec(std::mt19937& rng) {
+    forEachText(rng, checkCodecEncrypt);
+    forEachCiphertext(rng, checkCodecDecrypt);
+}
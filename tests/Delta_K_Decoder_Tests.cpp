@@ -0,0 +1,52 @@
+#include "Delta_K_Tests.hpp"
+#include "Delta_K.hpp"
+#include "Delta_K_Baseline.hpp"
+#include "Delta_K_Engine.hpp"
+
+#include <algorithm>
+
+/**
+ * @brief Uppercases the ASCII letters of a text, as a round trip does.
+ */
+static std::string upperCase(std::string text) {
+    for (char& c : text) {
+        if (isLetterByte(static_cast<unsigned char>(c))) c = static_cast<char>(c & ~0x20);
+    }
+
+    return text;
+}
+
+/**
+ * @brief Checks the string decoder on one ciphertext against the scalar decoder.
+ */
+static void checkDecrypt(std::mt19937&, const std::string& ciphertext, const std::string& key) {
+    check(decrypt(ciphertext, key) == referenceDecrypt(ciphertext, key), describe("decrypt", ciphertext.length(), key));
+}
+
+/**
+ * @brief Checks that decrypting an encryption gives the text back (uppercased), and that
+ * the baseline decoder agrees. Only meaningful for texts without glyph bytes.
+ */
+static void checkRoundTrip(const std::string& text, const std::string& key) {
+    const std::string ciphertext = encrypt(text, key);
+    const std::string expected = upperCase(text);
+
+    check(decrypt(ciphertext, key) == expected, describe("round trip", text.length(), key));
+    if (key.empty()) check(baseline::decrypt(ciphertext) == expected, describe("baseline round trip", text.length(), key));
+}
+
+/**
+ * @brief The byte-level decoder and its inverse tables, in both modes.
+ */
+void testDecoder(std::mt19937& rng) {
+    forEachCiphertext(rng, checkDecrypt);
+
+    for (size_t keyLength : {size_t{0}, size_t{5}, size_t{70}}) {
+        const std::string key = randomKey(rng, keyLength);
+        for (size_t length = 0; length <= 200; length++) {
+            std::string text = randomText(rng, length, 0.6);
+            std::replace(text.begin(), text.end(), '\xE2', '#');
+            checkRoundTrip(text, key);
+        }
+    }
+}
@@ -0,0 +1,16 @@
+#include "Delta_K_Tests.hpp"
+#include "Delta_K.hpp"
+
+/**
+ * @brief Checks the string encoder on one text against the baseline encoder.
+ */
+static void checkEncrypt(std::mt19937&, const std::string& text, const std::string& key) {
+    check(encrypt(text, key) == referenceEncrypt(text, key), describe("encrypt", text.length(), key));
+}
+
+/**
+ * @brief The table-driven encoder, in both modes.
+ */
+void testEncoder(std::mt19937& rng) {
+    forEachText(rng, checkEncrypt);
+}
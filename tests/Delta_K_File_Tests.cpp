@@ -0,0 +1,188 @@
+#include "Delta_K_Tests.hpp"
+#include "Delta_K.hpp"
+#include "Delta_K_AsyncIO.hpp"
+#include "Delta_K_File.hpp"
+#include "Delta_K_Pipeline.hpp"
+
+#include <filesystem>
+#include <fstream>
+#include <iterator>
+#include <thread>
+#include <vector>
+
+#include <csignal>
+#include <fcntl.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+/**
+ * @brief Writes a whole file.
+ */
+static void writeFile(const std::string& path, const std::string& data) {
+    std::ofstream file(path, std::ios::binary | std::ios::trunc);
+    file.write(data.data(), static_cast<std::streamsize>(data.length()));
+}
+
+/**
+ * @brief Reads a whole file; a missing file reads as a marker no output can equal.
+ */
+static std::string readFile(const std::string& path) {
+    std::ifstream file(path, std::ios::binary);
+    if (!file) return "<missing>";
+
+    return std::string(std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>());
+}
+
+/**
+ * @brief A file codec under test: (encrypting, input path, output path, key) -> success.
+ */
+using FileCodec = bool (*)(bool encrypting, const std::string& input, const std::string& output,
+                           const std::string& key);
+
+static bool mappedCodec(bool encrypting, const std::string& input, const std::string& output, const std::string& key) {
+    return encrypting ? encryptMappedFile(input, output, key, MapHints(), 3)
+                      : decryptMappedFile(input, output, key, MapHints(), 3);
+}
+
+/**
+ * @brief The async options under test: small odd blocks, so block ends cut triplets.
+ */
+static AsyncOptions asyncOptions(IoBackend backend) {
+    AsyncOptions options;
+    options.backend = backend;
+    options.depth = 3;
+    options.blockSize = 4099;
+    return options;
+}
+
+static bool uringCodec(bool encrypting, const std::string& input, const std::string& output, const std::string& key) {
+    return encrypting ? encryptFileAsync(input, output, key, asyncOptions(IoBackend::Uring))
+                      : decryptFileAsync(input, output, key, asyncOptions(IoBackend::Uring));
+}
+
+static bool preadCodec(bool encrypting, const std::string& input, const std::string& output, const std::string& key) {
+    return encrypting ? encryptFileAsync(input, output, key, asyncOptions(IoBackend::Pread))
+                      : decryptFileAsync(input, output, key, asyncOptions(IoBackend::Pread));
+}
+
+static bool pipelinedCodec(bool encrypting, const std::string& input, const std::string& output,
+                           const std::string& key) {
+    PipelineOptions options;
+    options.workers = 3;
+    options.chunkSize = 1000;
+
+    std::ifstream in(input, std::ios::binary);
+    std::ofstream out(output, std::ios::binary | std::ios::trunc);
+    return encrypting ? encryptPipelined(in, out, key, options) : decryptPipelined(in, out, key, options);
+}
+
+/**
+ * @brief The pipelined codec on a budget too small for its workers: two chunks, so only
+ * one of the three workers may start.
+ */
+static bool starvedPipelineCodec(bool encrypting, const std::string& input, const std::string& output,
+                                 const std::string& key) {
+    PipelineOptions options;
+    options.workers = 3;
+    options.chunkSize = 1000;
+    options.memoryBudget = 1;
+
+    std::ifstream in(input, std::ios::binary);
+    std::ofstream out(output, std::ios::binary | std::ios::trunc);
+    return encrypting ? encryptPipelined(in, out, key, options) : decryptPipelined(in, out, key, options);
+}
+
+/**
+ * @brief Runs a file codec on a FIFO fed by a writer thread.
+ *
+ * @return bool Whether the codec reported success.
+ */
+static bool runOnFifo(FileCodec codec, bool encrypting, const std::string& fifo, const std::string& output,
+                      const std::string& data, const std::string& key) {
+    std::thread writer([&fifo, &data] {
+        const int fd = open(fifo.c_str(), O_WRONLY);
+        if (fd < 0) return;
+        for (size_t done = 0; done < data.length();) {
+            const ssize_t wrote = write(fd, data.data() + done, data.length() - done);
+            if (wrote <= 0) break;
+            done += static_cast<size_t>(wrote);
+        }
+        close(fd);
+    });
+
+    const bool ok = codec(encrypting, fifo, output, key);
+
+    // A codec that refused the FIFO without opening it leaves the writer waiting for a reader.
+    const int drain = open(fifo.c_str(), O_RDONLY | O_NONBLOCK);
+    writer.join();
+    if (drain >= 0) close(drain);
+
+    return ok;
+}
+
+/**
+ * @brief Every file codec on regular files and on FIFOs, against the baseline encoder and
+ * the scalar decoder. Memory mapping must refuse a FIFO; the others must stream it.
+ */
+void testFiles(std::mt19937& rng) {
+    std::signal(SIGPIPE, SIG_IGN);
+
+    const std::filesystem::path directory =
+        std::filesystem::temp_directory_path() / ("delta-k-tests-" + std::to_string(getpid()));
+    std::filesystem::create_directories(directory);
+    const std::string input = (directory / "input").string();
+    const std::string output = (directory / "output").string();
+    const std::string fifo = (directory / "fifo").string();
+
+    struct NamedCodec {
+        const char* name;
+        FileCodec codec;
+        bool streamsFifo;
+    };
+    std::vector<NamedCodec> codecs = {{"mmap", mappedCodec, false}, {"pread", preadCodec, true},
+                                      {"pipelined", pipelinedCodec, true},
+                                      {"pipelined on two chunks", starvedPipelineCodec, true}};
+    if (uringAvailable()) codecs.push_back({"uring", uringCodec, true});
+
+    const std::vector<std::string> texts = {std::string(), randomText(rng, 1, 1.0), randomText(rng, 4099, 0.5),
+                                            randomText(rng, 70001, 0.8)};
+    const std::vector<std::string> ciphertexts = {std::string(), randomCiphertext(rng, 4099),
+                                                  randomCiphertext(rng, 70001), encrypt(texts.back(), "Key")};
+
+    for (const NamedCodec& named : codecs) {
+        const std::string name = named.name;
+
+        for (const std::string& key : {std::string(), std::string("Delta")}) {
+            for (const std::string& text : texts) {
+                writeFile(input, text);
+                check(named.codec(true, input, output, key) && readFile(output) == referenceEncrypt(text, key),
+                      describe(name + " encrypt", text.length(), key));
+            }
+            for (const std::string& ciphertext : ciphertexts) {
+                writeFile(input, ciphertext);
+                check(named.codec(false, input, output, key) && readFile(output) == referenceDecrypt(ciphertext, key),
+                      describe(name + " decrypt", ciphertext.length(), key));
+            }
+        }
+
+        if (mkfifo(fifo.c_str(), 0600) != 0) {
+            check(false, "mkfifo " + fifo);
+            continue;
+        }
+        const std::string& text = texts[2];
+        const std::string& ciphertext = ciphertexts[2];
+        const bool encrypted = runOnFifo(named.codec, true, fifo, output, text, "Delta");
+        if (named.streamsFifo) {
+            check(encrypted && readFile(output) == referenceEncrypt(text, "Delta"),
+                  describe(name + " encrypt from a FIFO", text.length(), "Delta"));
+            check(runOnFifo(named.codec, false, fifo, output, ciphertext, "") &&
+                      readFile(output) == referenceDecrypt(ciphertext, ""),
+                  describe(name + " decrypt from a FIFO", ciphertext.length(), ""));
+        } else {
+            check(!encrypted, describe(name + " must refuse a FIFO", text.length(), "Delta"));
+        }
+        std::filesystem::remove(fifo);
+    }
+
+    std::filesystem::remove_all(directory);
+}
@@ -0,0 +1,66 @@
+#include "Delta_K_Tests.hpp"
+#include "Delta_K.hpp"
+#include "Delta_K_Dispatch.hpp"
+#include "Delta_K_Engine.hpp"
+#include "Delta_K_Tables.hpp"
+
+/**
+ * @brief Checks the bound encode kernels on one text against the scalar engine. Keyed
+ * kernels start at a random key position, as the parallel and streaming paths call them.
+ */
+static void checkEncodeKernels(std::mt19937& rng, const std::string& text, const std::string& key) {
+    const KernelSet& kernels = activeKernels();
+    const unsigned char* in = reinterpret_cast<const unsigned char*>(text.data());
+    std::string scalar(text.length() * TRIPLET_SIZE, '\0');
+    std::string kernel(text.length() * TRIPLET_SIZE, '\0');
+    unsigned char* scalarOut = reinterpret_cast<unsigned char*>(&scalar[0]);
+    unsigned char* kernelOut = reinterpret_cast<unsigned char*>(&kernel[0]);
+
+    check(kernels.countLetters(in, text.length()) == countLetters(in, text.length()),
+          describe("countLetters kernel", text.length(), key));
+
+    if (key.empty()) {
+        scalar.resize(encodeStandard(in, text.length(), scalarOut));
+        kernel.resize(kernels.encodeStandard(in, text.length(), kernelOut));
+        check(kernel == scalar, describe("encodeStandard kernel", text.length(), key));
+    } else {
+        const DeltaKey compiled(key);
+        const size_t keyIndex = rng() % compiled.length();
+        scalar.resize(encodeKeyed(in, text.length(), compiled.codes(), compiled.length(), keyIndex, scalarOut));
+        kernel.resize(kernels.encodeKeyed(in, text.length(), compiled.codes(), compiled.length(), keyIndex, kernelOut));
+        check(kernel == scalar, describe("encodeKeyed kernel at a key offset", text.length(), key));
+    }
+}
+
+/**
+ * @brief Checks the bound decode kernels on one ciphertext against the scalar engine.
+ */
+static void checkDecodeKernels(std::mt19937& rng, const std::string& ciphertext, const std::string& key) {
+    const KernelSet& kernels = activeKernels();
+    const unsigned char* in = reinterpret_cast<const unsigned char*>(ciphertext.data());
+    std::string scalar(ciphertext.length(), '\0');
+    std::string kernel(ciphertext.length(), '\0');
+    unsigned char* scalarOut = reinterpret_cast<unsigned char*>(&scalar[0]);
+    unsigned char* kernelOut = reinterpret_cast<unsigned char*>(&kernel[0]);
+
+    if (key.empty()) {
+        scalar.resize(decodeStandard(in, ciphertext.length(), scalarOut));
+        kernel.resize(kernels.decodeStandard(in, ciphertext.length(), kernelOut));
+        check(kernel == scalar, describe("decodeStandard kernel", ciphertext.length(), key));
+    } else {
+        const DeltaKey compiled(key);
+        const size_t keyIndex = rng() % compiled.length();
+        scalar.resize(decodeKeyed(in, ciphertext.length(), compiled.codes(), compiled.length(), keyIndex, scalarOut));
+        kernel.resize(
+            kernels.decodeKeyed(in, ciphertext.length(), compiled.codes(), compiled.length(), keyIndex, kernelOut));
+        check(kernel == scalar, describe("decodeKeyed kernel at a key offset", ciphertext.length(), key));
+    }
+}
+
+/**
+ * @brief The kernels of the dispatched tier against the scalar engine, in both modes.
+ */
+void testKernels(std::mt19937& rng) {
+    forEachText(rng, checkEncodeKernels);
+    forEachCiphertext(rng, checkDecodeKernels);
+}
@@ -0,0 +1,51 @@
+#include "Delta_K_Tests.hpp"
+#include "Delta_K.hpp"
+#include "Delta_K_Key.hpp"
+
+/**
+ * @brief The key every check recompiles with assign(), so its storage is reused across
+ * keys longer and shorter than the one before.
+ */
+static DeltaKey& sharedKey() {
+    static DeltaKey key;
+    return key;
+}
+
+static void checkKeyEncrypt(std::mt19937&, const std::string& text, const std::string& key) {
+    const std::string expected = referenceEncrypt(text, key);
+    DeltaKey& compiled = sharedKey();
+    compiled.assign(key);
+
+    check(encrypt(text, compiled) == expected, describe("encrypt (DeltaKey)", text.length(), key));
+
+    std::string into(expected.length(), '\0');
+    check(encryptInto(text, compiled, &into[0]) == expected.length() && into == expected,
+          describe("encryptInto (DeltaKey)", text.length(), key));
+}
+
+static void checkKeyDecrypt(std::mt19937&, const std::string& ciphertext, const std::string& key) {
+    const std::string expected = referenceDecrypt(ciphertext, key);
+    DeltaKey& compiled = sharedKey();
+    compiled.assign(key);
+
+    check(decrypt(ciphertext, compiled) == expected, describe("decrypt (DeltaKey)", ciphertext.length(), key));
+
+    std::string into(ciphertext.length(), '\0');
+    check(decryptInto(ciphertext, compiled, &into[0]) == expected.length() &&
+              into.compare(0, expected.length(), expected) == 0,
+          describe("decryptInto (DeltaKey)", ciphertext.length(), key));
+}
+
+/**
+ * @brief The compiled key: validation, and every overload that takes one.
+ */
+void testKeys(std::mt19937& rng) {
+    DeltaKey parsed("Old");
+    check(!DeltaKey::parse("Key1", parsed) && parsed.length() == 3, "DeltaKey::parse must reject a digit");
+    check(!DeltaKey::parse("Two words", parsed) && parsed.length() == 3, "DeltaKey::parse must reject a space");
+    check(DeltaKey::parse("dElTa", parsed) && parsed.length() == 5, "DeltaKey::parse must accept mixed case");
+    check(DeltaKey::parse("", parsed) && parsed.empty(), "DeltaKey::parse must accept Standard Mode");
+
+    forEachText(rng, checkKeyEncrypt);
+    forEachCiphertext(rng, checkKeyDecrypt);
+}
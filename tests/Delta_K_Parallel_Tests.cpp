@@ -0,0 +1,26 @@
+#include "Delta_K_Tests.hpp"
+#include "Delta_K_Parallel.hpp"
+
+/**
+ * @brief Inputs large enough that the parallel codec really splits them into chunks.
+ */
+constexpr size_t PARALLEL_TEXT_LENGTH = (size_t{3} << 19) + 37;
+
+/**
+ * @brief The multithreaded codec against the baseline, on texts large enough to split.
+ */
+void testParallel(std::mt19937& rng) {
+    const std::string text = randomText(rng, PARALLEL_TEXT_LENGTH, 0.7);
+    const std::string ciphertext = randomCiphertext(rng, PARALLEL_TEXT_LENGTH);
+
+    for (const std::string& key : {std::string(), randomKey(rng, 13)}) {
+        const std::string expected = referenceEncrypt(text, key);
+        const std::string decoded = referenceDecrypt(ciphertext, key);
+
+        for (unsigned threads = 1; threads <= 4; threads++) {
+            check(encryptParallel(text, key, threads) == expected, describe("encryptParallel", text.length(), key));
+            check(decryptParallel(ciphertext, key, threads) == decoded,
+                  describe("decryptParallel", ciphertext.length(), key));
+        }
+    }
+}
@@ -0,0 +1,49 @@
+#include "Delta_K_Tests.hpp"
+#include "Delta_K.hpp"
+
+#include <iterator>
+
+/**
+ * @brief Checks the size query, the span and the sink encoders on one text against the
+ * baseline encoder.
+ */
+static void checkEncryptInto(std::mt19937&, const std::string& text, const std::string& key) {
+    const std::string expected = referenceEncrypt(text, key);
+
+    check(encodedSize(text) == expected.length(), describe("encodedSize", text.length(), key));
+
+    std::string into(expected.length(), '\0');
+    check(encryptInto(text, key, &into[0]) == expected.length() && into == expected,
+          describe("encryptInto", text.length(), key));
+
+    std::string sink;
+    encryptTo(text, key, std::back_inserter(sink));
+    check(sink == expected, describe("encryptTo", text.length(), key));
+}
+
+/**
+ * @brief Checks the size query, the span and the sink decoders on one ciphertext against
+ * the scalar decoder.
+ */
+static void checkDecryptInto(std::mt19937&, const std::string& ciphertext, const std::string& key) {
+    const std::string expected = referenceDecrypt(ciphertext, key);
+
+    check(decodedSize(ciphertext) == expected.length(), describe("decodedSize", ciphertext.length(), key));
+
+    std::string into(ciphertext.length(), '\0');
+    check(decryptInto(ciphertext, key, &into[0]) == expected.length() &&
+              into.compare(0, expected.length(), expected) == 0,
+          describe("decryptInto", ciphertext.length(), key));
+
+    std::string sink;
+    decryptTo(ciphertext, key, std::back_inserter(sink));
+    check(sink == expected, describe("decryptTo", ciphertext.length(), key));
+}
+
+/**
+ * @brief The allocation-free span and sink API, in both modes.
+ */
+void testSinks(std::mt19937& rng) {
+    forEachText(rng, checkEncryptInto);
+    forEachCiphertext(rng, checkDecryptInto);
+}
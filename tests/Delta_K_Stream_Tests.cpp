@@ -0,0 +1,92 @@
+#include "Delta_K_Tests.hpp"
+#include "Delta_K.hpp"
+#include "Delta_K_Stream.hpp"
+#include "Delta_K_Tables.hpp"
+
+#include <algorithm>
+#include <string_view>
+#include <vector>
+
+/**
+ * @brief Streams one text through the encoder in random pieces, alternating both feed()
+ * overloads, against the baseline encoder.
+ */
+static void checkEncoder(std::mt19937& rng, const std::string& text, const std::string& key) {
+    DeltaKEncoder encoder(key);
+    std::uniform_int_distribution<size_t> piece(0, 97);
+    std::vector<char> buffer;
+    std::string streamed;
+    bool own = false;
+
+    for (size_t i = 0; i < text.length(); own = !own) {
+        const size_t length = std::min(piece(rng), text.length() - i);
+        const std::string_view part(text.data() + i, length);
+        if (own) {
+            buffer.resize((length * TRIPLET_SIZE) + 1);
+            streamed.append(buffer.data(), encoder.feed(part, buffer.data()));
+        } else {
+            streamed += encoder.feed(part);
+        }
+        i += length;
+    }
+    streamed += encoder.finish();
+
+    check(streamed == referenceEncrypt(text, key), describe("DeltaKEncoder", text.length(), key));
+}
+
+/**
+ * @brief Streams one ciphertext through the decoder in random pieces of 0 to 20 bytes, so
+ * most triplets are cut somewhere, against the scalar decoder.
+ */
+static void checkDecoder(std::mt19937& rng, const std::string& ciphertext, const std::string& key) {
+    DeltaKDecoder decoder(key);
+    std::uniform_int_distribution<size_t> piece(0, 20);
+    std::vector<char> buffer;
+    std::string streamed;
+    bool own = false;
+
+    for (size_t i = 0; i < ciphertext.length(); own = !own) {
+        const size_t length = std::min(piece(rng), ciphertext.length() - i);
+        const std::string_view part(ciphertext.data() + i, length);
+        if (own) {
+            buffer.resize(length + TRIPLET_SIZE);
+            streamed.append(buffer.data(), decoder.feed(part, buffer.data()));
+        } else {
+            streamed += decoder.feed(part);
+        }
+        i += length;
+    }
+    streamed += decoder.finish();
+
+    check(streamed == referenceDecrypt(ciphertext, key), describe("DeltaKDecoder", ciphertext.length(), key));
+}
+
+/**
+ * @brief Splits a ciphertext at every position, so each glyph and triplet boundary (and
+ * every point inside them) falls between two feed() calls.
+ */
+static void checkEverySplit(const std::string& ciphertext, const std::string& key) {
+    const std::string expected = referenceDecrypt(ciphertext, key);
+
+    for (size_t split = 0; split <= ciphertext.length(); split++) {
+        DeltaKDecoder decoder(key);
+        std::string streamed(decoder.feed(std::string_view(ciphertext).substr(0, split)));
+        streamed += decoder.feed(std::string_view(ciphertext).substr(split));
+        streamed += decoder.finish();
+        check(streamed == expected, describe("DeltaKDecoder split at " + std::to_string(split), ciphertext.length(), key));
+    }
+}
+
+/**
+ * @brief The streaming encoder and decoder, whose state carries over between pieces.
+ */
+void testStream(std::mt19937& rng) {
+    forEachText(rng, checkEncoder);
+    forEachCiphertext(rng, checkDecoder);
+
+    for (size_t length : {size_t{40}, size_t{150}}) {
+        checkEverySplit(randomCiphertext(rng, length), "");
+        checkEverySplit(randomCiphertext(rng, length), "Delta");
+        checkEverySplit(encrypt(randomText(rng, length / TRIPLET_SIZE, 0.9)), "");
+    }
+}
@@ -0,0 +1,234 @@
+#include "Delta_K_Tests.hpp"
+#include "Delta_K.hpp"
+#include "Delta_K_Baseline.hpp"
+#include "Delta_K_Dispatch.hpp"
+#include "Delta_K_Engine.hpp"
+#include "Delta_K_Tables.hpp"
+
+#include <algorithm>
+#include <cstdlib>
+#include <iostream>
+
+/**
+ * @brief The exit code ctest reads as "skipped" (see SKIP_RETURN_CODE in CMakeLists.txt).
+ */
+constexpr int SKIP_EXIT_CODE = 77;
+
+/**
+ * @brief The most failures printed; the rest are only counted.
+ */
+constexpr int REPORTED_FAILURES = 20;
+
+static int failures = 0;
+
+/**
+ * @brief Records a failed expectation, printing the first few.
+ *
+ * @param ok The expectation.
+ * @param what What was checked, and on which input.
+ */
+void check(bool ok, const std::string& what) {
+    if (ok) return;
+
+    if (failures++ < REPORTED_FAILURES) std::cerr << "FAIL: " << what << std::endl;
+}
+
+/**
+ * @brief Describes a test input for failure messages.
+ */
+std::string describe(const std::string& path, size_t length, const std::string& key) {
+    return path + " (length " + std::to_string(length) + ", key length " + std::to_string(key.length()) + ")";
+}
+
+/**
+ * @brief The baseline (pre-optimization) encoder every path is checked against.
+ */
+std::string referenceEncrypt(const std::string& plaintext, const std::string& key) {
+    return key.empty() ? baseline::encrypt(plaintext) : baseline::encrypt(plaintext, key);
+}
+
+/**
+ * @brief The scalar byte-level decoder every path is checked against.
+ * The baseline decoder reads past malformed glyph runs, so it only checks well-formed
+ * ciphertext (see testDecoder()).
+ */
+std::string referenceDecrypt(const std::string& ciphertext, const std::string& key) {
+    const unsigned char* in = reinterpret_cast<const unsigned char*>(ciphertext.data());
+    std::string plaintext(ciphertext.length(), '\0');
+    unsigned char* out = reinterpret_cast<unsigned char*>(&plaintext[0]);
+
+    if (key.empty()) {
+        plaintext.resize(decodeStandard(in, ciphertext.length(), out));
+    } else {
+        const DeltaKey compiled(key);
+        plaintext.resize(decodeKeyed(in, ciphertext.length(), compiled.codes(), compiled.length(), 0, out));
+    }
+
+    return plaintext;
+}
+
+/**
+ * @brief Bytes next to the letter ranges, high bytes that are letters with bit 7 set, and
+ * the glyph bytes, which every letter test must keep apart from letters.
+ */
+static const unsigned char EDGE_BYTES[] = {'@', '[', '`', '{', ' ', '\n', '.', '0', '9', 0x00, 0x7F, 0x80, 0xC1,
+                                           0xDA, 0xE1, 0xFA, 0xFF, 0xE2, 0x96, 0x97, 0xB2, 0xBC, 0x86};
+
+/**
+ * @brief A random text in which a fraction `density` of the bytes are letters (of either
+ * case); the rest are EDGE_BYTES.
+ */
+std::string randomText(std::mt19937& rng, size_t length, double density) {
+    std::bernoulli_distribution letter(density);
+    std::uniform_int_distribution<int> alphabet(0, (ALPHABET_LENGTH * 2) - 1);
+    std::uniform_int_distribution<size_t> edge(0, sizeof(EDGE_BYTES) - 1);
+    std::string text(length, '\0');
+
+    for (char& c : text) {
+        const int a = alphabet(rng);
+        c = letter(rng) ? static_cast<char>(a < ALPHABET_LENGTH ? 'A' + a : 'a' + a - ALPHABET_LENGTH)
+                        : static_cast<char>(EDGE_BYTES[edge(rng)]);
+    }
+
+    return text;
+}
+
+/**
+ * @brief A random key of `length` letters of either case.
+ */
+std::string randomKey(std::mt19937& rng, size_t length) {
+    std::uniform_int_distribution<int> alphabet(0, (ALPHABET_LENGTH * 2) - 1);
+    std::string key(length, 'A');
+
+    for (char& c : key) {
+        const int a = alphabet(rng);
+        c = static_cast<char>(a < ALPHABET_LENGTH ? 'A' + a : 'a' + a - ALPHABET_LENGTH);
+    }
+
+    return key;
+}
+
+/**
+ * @brief A random ciphertext: runs of 1 to 30 valid glyphs mixed with plain bytes, cut
+ * glyphs (E2, E2 96) and byte sequences that only look like glyphs (E2 96 B3, E2 97 B2).
+ */
+std::string randomCiphertext(std::mt19937& rng, size_t length) {
+    static const char* const PIECES[] = {"\xE2", "\xE2\x96", "\xE2\x97", "\xE2\x96\xB3", "\xE2\x97\xB2",
+                                         "\xE2\x96\x86", "a", "Z", " ", "\xB2", "\x86", "@"};
+    std::uniform_int_distribution<int> kind(0, 9);
+    std::uniform_int_distribution<int> run(1, 30);
+    std::uniform_int_distribution<int> glyph(0, 2);
+    std::uniform_int_distribution<size_t> piece(0, (sizeof(PIECES) / sizeof(PIECES[0])) - 1);
+    std::string text;
+
+    while (text.length() < length) {
+        if (kind(rng) < 6) {
+            for (int g = run(rng); g > 0; g--) text += GLYPHS[glyph(rng)];
+        } else {
+            text += PIECES[piece(rng)];
+        }
+    }
+    text.resize(length);
+
+    return text;
+}
+
+/**
+ * @brief The key lengths every group runs: none, around the 64-letter key blocks, and
+ * longer than any chunk of text.
+ */
+static const size_t KEY_LENGTHS[] = {0, 1, 2, 3, 7, 26, 63, 64, 65, 100, 1500};
+
+/**
+ * @brief Runs a check on random and edge texts in both modes.
+ */
+void forEachText(std::mt19937& rng, CaseCheck checkText) {
+    const double densities[] = {0.0, 0.2, 0.5, 0.8, 1.0};
+
+    for (size_t keyLength : KEY_LENGTHS) {
+        const std::string key = randomKey(rng, keyLength);
+
+        // Every length around the 8, 16, 32 and 64 byte blocks and their margins.
+        for (size_t length = 0; length <= 300; length++) {
+            for (double density : densities) checkText(rng, randomText(rng, length, density), key);
+        }
+
+        // Longer texts cross the sink pieces and the streaming buffers.
+        for (size_t length : {size_t{2047}, size_t{2048}, size_t{4099}, size_t{20000}}) {
+            for (double density : densities) checkText(rng, randomText(rng, length, density), key);
+        }
+    }
+}
+
+/**
+ * @brief Runs a check on random, well-formed and edge ciphertexts in both modes.
+ */
+void forEachCiphertext(std::mt19937& rng, CaseCheck checkCiphertext) {
+    for (size_t keyLength : KEY_LENGTHS) {
+        const std::string key = randomKey(rng, keyLength);
+
+        for (size_t length = 0; length <= 300; length++) checkCiphertext(rng, randomCiphertext(rng, length), key);
+        for (size_t length : {size_t{2047}, size_t{2048}, size_t{4099}, size_t{20000}}) {
+            checkCiphertext(rng, randomCiphertext(rng, length), key);
+        }
+    }
+
+    // Well-formed ciphertext: encryptions of texts without glyph bytes.
+    for (size_t keyLength : {size_t{0}, size_t{5}, size_t{70}}) {
+        const std::string key = randomKey(rng, keyLength);
+        for (size_t length = 0; length <= 200; length++) {
+            std::string text = randomText(rng, length, 0.6);
+            std::replace(text.begin(), text.end(), '\xE2', '#');
+            checkCiphertext(rng, referenceEncrypt(text, key), key);
+        }
+    }
+
+    // Glyph runs of every length after every offset: the triplet grouping must restart at
+    // each run, and the leftover glyphs of a run must pass through.
+    for (size_t offset = 0; offset < 70; offset++) {
+        for (int glyphs = 1; glyphs <= 40; glyphs++) {
+            std::string ciphertext(offset, 'x');
+            for (int g = 0; g < glyphs; g++) ciphertext += GLYPHS[(g * 7 + offset) % 3];
+            ciphertext += "\xE2\x96";
+            checkCiphertext(rng, ciphertext, "");
+            checkCiphertext(rng, ciphertext, "Key");
+        }
+    }
+}
+
+/**
+ * @brief Runs every test group through the kernel tier named by DELTA_K_TIER (or the
+ * default binding).
+ *
+ * @return int 0 if every check passed, 1 if any failed, SKIP_EXIT_CODE if the requested
+ * tier does not run on this CPU.
+ */
+int main() {
+    const char* forced = std::getenv(TIER_ENVIRONMENT);
+    if (forced && *forced) {
+        KernelTier tier;
+        if (!parseTier(forced, tier)) {
+            std::cerr << TIER_ENVIRONMENT << ": unknown tier '" << forced << "'" << std::endl;
+            return 1;
+        }
+        if (!tierSupported(tier)) {
+            std::cout << "tier " << forced << " is not supported on this CPU, skipping" << std::endl;
+            return SKIP_EXIT_CODE;
+        }
+        check(activeKernels().tier == tier, std::string("bound tier is not ") + forced);
+    }
+
+    std::mt19937 rng(20261016);
+    testEncoder(rng);
+    testDecoder(rng);
+    testKernels(rng);
+    testParallel(rng);
+    testStream(rng);
+    testSinks(rng);
+    testCodec(rng);
+    testKeys(rng);
+    testFiles(rng);
+
+    std::cout << "tier " << tierName(activeKernels().tier) << ": " << failures << " failure(s)" << std::endl;
+    return failures ? 1 : 0;
+}
@@ -0,0 +1,35 @@
+#ifndef DELTA_K_TESTS_HPP
+#define DELTA_K_TESTS_HPP
+
+#include <cstddef>
+#include <random>
+#include <string>
+
+/**
+ * @brief A check run on one generated input: (generator, text or ciphertext, key).
+ */
+using CaseCheck = void (*)(std::mt19937& rng, const std::string& input, const std::string& key);
+
+// Test harness
+void check(bool ok, const std::string& what);
+std::string describe(const std::string& path, size_t length, const std::string& key);
+std::string referenceEncrypt(const std::string& plaintext, const std::string& key);
+std::string referenceDecrypt(const std::string& ciphertext, const std::string& key);
+std::string randomText(std::mt19937& rng, size_t length, double density);
+std::string randomKey(std::mt19937& rng, size_t length);
+std::string randomCiphertext(std::mt19937& rng, size_t length);
+void forEachText(std::mt19937& rng, CaseCheck checkText);
+void forEachCiphertext(std::mt19937& rng, CaseCheck checkCiphertext);
+
+// Test groups
+void testEncoder(std::mt19937& rng);
+void testDecoder(std::mt19937& rng);
+void testKernels(std::mt19937& rng);
+void testParallel(std::mt19937& rng);
+void testStream(std::mt19937& rng);
+void testSinks(std::mt19937& rng);
+void testCodec(std::mt19937& rng);
+void testKeys(std::mt19937& rng);
+void testFiles(std::mt19937& rng);
+
+#endif